@@ -18,3 +18,280 @@
  *************************************************************************/
 
 #include "inspireanimation.h"
+
+#include <QGuiApplication>
+#include <QScreen>
+#include <QTimerEvent>
+#include <QtMath>
+
+namespace Inspire
+{
+
+    //_________________________________________________________________________________
+    AnimationTimeline::~AnimationTimeline( void )
+    { if( isRunning() ) AnimationClock::instance().unregisterAnimation( this ); }
+
+    //_________________________________________________________________________________
+    int AnimationTimeline::currentTime( void ) const
+    {
+        if( _duration <= 0 ) return 0;
+
+        // the last loop ends at its duration rather than at zero
+        const qint64 total( totalDuration() );
+        if( total >= 0 && _time >= total ) return _duration;
+        else return int( _time % _duration );
+    }
+
+    //_________________________________________________________________________________
+    void AnimationTimeline::setDuration( int value )
+    {
+        _duration = qMax( 0, value );
+        if( isRunning() && _stepped ) _stepCount = AnimationClock::instance().steps( _duration );
+    }
+
+    //_________________________________________________________________________________
+    void AnimationTimeline::start( void )
+    {
+        if( isRunning() ) return;
+
+        const qint64 total( totalDuration() );
+        if( _direction == Forward ) _time = 0;
+        else _time = total < 0 ? _duration : total;
+
+        // register first, so that steps match the frame interval in use
+        AnimationClock& clock( AnimationClock::instance() );
+        clock.registerAnimation( this );
+        _stepCount = _stepped ? clock.steps( _duration ) : 0;
+        _written = false;
+        updateValue();
+    }
+
+    //_________________________________________________________________________________
+    void AnimationTimeline::stop( void )
+    {
+        if( !isRunning() ) return;
+        AnimationClock::instance().unregisterAnimation( this );
+
+        // same as QAbstractAnimation, finished is also emitted when stopping an infinite animation
+        if( totalDuration() < 0 || atEnd() ) finish();
+    }
+
+    //_________________________________________________________________________________
+    bool AnimationTimeline::atEnd( void ) const
+    {
+        const qint64 total( totalDuration() );
+        if( total < 0 ) return false;
+        else if( _direction == Forward ) return _time >= total;
+        else return _time <= 0;
+    }
+
+    //_________________________________________________________________________________
+    bool AnimationTimeline::advance( qint64 elapsed )
+    {
+        if( _direction == Forward ) _time += elapsed;
+        else _time -= elapsed;
+
+        const qint64 total( totalDuration() );
+        if( total >= 0 ) _time = qBound<qint64>( 0, _time, total );
+        else if( _duration > 0 ) _time = ( _time%_duration + _duration )%_duration;
+        else _time = 0;
+
+        updateValue();
+        return !atEnd();
+    }
+
+    //_________________________________________________________________________________
+    void AnimationTimeline::updateValue( void )
+    {
+        qreal progress( _duration > 0 ? qreal( currentTime() )/_duration : 1 );
+        if( !_stepped )
+        {
+            setValue( _startValue + ( _endValue - _startValue )*progress );
+            return;
+        }
+
+        // digitize, as a multiple of 1/steps so that digitizing again does not change it
+        AnimationClock& clock( AnimationClock::instance() );
+        if( _stepCount > 0 )
+        {
+            const int steps( clock.steps() );
+            progress = qreal( qFloor( progress*_stepCount )*( steps/_stepCount ) )/steps;
+        }
+
+        const qreal value( _startValue + ( _endValue - _startValue )*progress );
+        if( _written && value == _value )
+        {
+            ++clock._statistics.skippedWrites;
+            return;
+        }
+
+        ++clock._statistics.writes;
+        _value = value;
+        _written = true;
+        setValue( value );
+    }
+
+    //_________________________________________________________________________________
+    AnimationClock& AnimationClock::instance( void )
+    {
+        // never deleted, so that animations destroyed late can still unregister
+        static AnimationClock* clock = new AnimationClock();
+        return *clock;
+    }
+
+    //_________________________________________________________________________________
+    int AnimationClock::steps( int duration ) const
+    {
+        if( _steps <= 0 ) return 0;
+
+        // frames spanned by the animation, including the first one
+        const int frames( qMax( 1, duration/_frameInterval + 1 ) );
+        if( frames >= _steps ) return _steps;
+
+        // smallest divisor of steps large enough
+        for( int steps = frames; steps < _steps; ++steps )
+        { if( _steps%steps == 0 ) return steps; }
+
+        return _steps;
+    }
+
+    //_________________________________________________________________________________
+    void AnimationClock::update( QWidget* widget, const QRect& rect )
+    {
+        if( !_ticking )
+        {
+            widget->update( rect );
+            return;
+        }
+
+        ++_statistics.requests;
+
+        // same as QWidget::update, hidden widgets are not updated
+        if( !widget->isVisible() ) return;
+
+        // map damage to the window, clipped by parents, unless painted in its own native window
+        QWidget* target( widget );
+        QRect damage( rect & widget->rect() );
+        for( QWidget* parent = widget; !parent->isWindow(); parent = parent->parentWidget() )
+        {
+            if( parent->testAttribute( Qt::WA_NativeWindow ) )
+            {
+                target = widget;
+                damage = rect & widget->rect();
+                break;
+            }
+
+            damage = damage.translated( parent->pos() ) & parent->parentWidget()->rect();
+            target = parent->parentWidget();
+        }
+
+        // proxied windows are updated through their widgets
+        if( target != widget && target->graphicsProxyWidget() )
+        {
+            target = widget;
+            damage = rect & widget->rect();
+        }
+
+        if( damage.isEmpty() ) return;
+
+        // merge with pending damage
+        const auto iter( _damageIndex.constFind( target ) );
+        if( iter != _damageIndex.constEnd() ) _damage[iter.value()].region += damage;
+        else {
+
+            _damageIndex.insert( target, _damage.size() );
+            _damage.append( { target, QRegion( damage ) } );
+
+        }
+    }
+
+    //_________________________________________________________________________________
+    void AnimationClock::timerEvent( QTimerEvent* event )
+    {
+        if( event->timerId() != _timer.timerId() ) return QObject::timerEvent( event );
+
+        ++_statistics.frames;
+        _ticking = true;
+
+        // step all running animations
+        const qint64 now( _elapsed.elapsed() );
+        for( int i = 0; i < _running.size(); ++i )
+        {
+            AnimationTimeline* animation( _running[i] );
+            const qint64 elapsed( now - animation->_lastStep );
+            animation->_lastStep = now;
+
+            ++_statistics.steps;
+            if( !animation->advance( elapsed ) ) _finished.append( animation );
+        }
+
+        // stop finished animations. This may start, stop or delete others, which then leave the list
+        for( int i = 0; i < _finished.size(); ++i )
+        {
+            AnimationTimeline* animation( _finished[i] );
+            if( animation && animation->atEnd() ) animation->stop();
+        }
+
+        _finished.clear();
+        _ticking = false;
+
+        // update each window once
+        for( const Damage& damage : _damage )
+        {
+            if( !damage.widget ) continue;
+            damage.widget.data()->update( damage.region );
+            ++_statistics.updates;
+        }
+
+        _damage.clear();
+        _damageIndex.clear();
+
+        if( _running.isEmpty() ) _timer.stop();
+    }
+
+    //_________________________________________________________________________________
+    void AnimationClock::registerAnimation( AnimationTimeline* animation )
+    {
+        animation->_index = _running.size();
+        animation->_lastStep = _elapsed.elapsed();
+        _running.append( animation );
+
+        if( !_timer.isActive() )
+        {
+            updateFrameInterval();
+            _timer.start( _frameInterval, Qt::PreciseTimer, this );
+        }
+    }
+
+    //_________________________________________________________________________________
+    void AnimationClock::updateFrameInterval( void )
+    {
+        // the style may be used without a gui application, or before a screen is available
+        const QScreen* screen( qobject_cast<QGuiApplication*>( QCoreApplication::instance() ) ? QGuiApplication::primaryScreen() : nullptr );
+        const qreal refreshRate( screen ? screen->refreshRate() : 0 );
+        _frameInterval = refreshRate > 0 ? qBound( 4, qRound( 1000/refreshRate ), 33 ) : FrameInterval;
+    }
+
+    //_________________________________________________________________________________
+    void AnimationClock::unregisterAnimation( AnimationTimeline* animation )
+    {
+        // move last animation in place of the removed one
+        const int index( animation->_index );
+        AnimationTimeline* last( _running.last() );
+        _running[index] = last;
+        last->_index = index;
+
+        _running.removeLast();
+        animation->_index = -1;
+
+        // make sure it is not stopped again at the end of the frame
+        if( _ticking )
+        {
+            const int finished( _finished.indexOf( animation ) );
+            if( finished >= 0 ) _finished[finished] = nullptr;
+        }
+
+        if( _running.isEmpty() && !_ticking ) _timer.stop();
+    }
+
+}
@@ -21,33 +21,123 @@
 
 #include "inspire.h"
 
-#include <QPropertyAnimation>
-#include <QVariant>
+#include <QBasicTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QRegion>
+#include <QVector>
+#include <QWidget>
+
+#include <functional>
 
 namespace Inspire
 {
 
-    class Animation: public QPropertyAnimation
+    //* linear animation timing from start to end value, stepped by the shared AnimationClock
+    /**
+    it mimics the subset of QPropertyAnimation used by the engines,
+    but writes its value through a setter rather than through the meta object system.
+    It is not a QObject, so that per widget animations can be pooled
+    */
+    class AnimationTimeline
     {
 
-        Q_OBJECT
-
         public:
 
-        //* convenience
-        using Pointer = WeakPointer<Animation>;
+        //* value setter
+        using Setter = std::function<void( qreal )>;
+
+        //* direction
+        enum Direction
+        {
+            Forward,
+            Backward
+        };
+
+        //* state
+        enum State
+        {
+            Stopped,
+            Running
+        };
 
         //* constructor
-        Animation( int duration, QObject* parent ):
-            QPropertyAnimation( parent )
-        { setDuration( duration ); }
+        explicit AnimationTimeline( int duration = 0 ):
+            _duration( duration )
+        {}
 
         //* destructor
-        virtual ~Animation( void ) = default;
+        virtual ~AnimationTimeline( void );
+
+        //*@name accessors
+        //@{
+
+        //* duration
+        int duration( void ) const
+        { return _duration; }
+
+        //* loop count
+        int loopCount( void ) const
+        { return _loopCount; }
+
+        //* direction
+        Direction direction( void ) const
+        { return _direction; }
+
+        //* state
+        State state( void ) const
+        { return _index < 0 ? Stopped : Running; }
 
         //* true if running
         bool isRunning( void ) const
-        { return state() == Animation::Running; }
+        { return state() == Running; }
+
+        //* time in current loop
+        int currentTime( void ) const;
+
+        //@}
+
+        //*@name modifiers
+        //@{
+
+        //* duration
+        void setDuration( int value );
+
+        //* loop count. Negative loops forever
+        void setLoopCount( int value )
+        { _loopCount = value; }
+
+        //* direction
+        /** a running animation continues from its current time */
+        void setDirection( Direction value )
+        { _direction = value; }
+
+        //* start value
+        void setStartValue( qreal value )
+        { _startValue = value; }
+
+        //* end value
+        void setEndValue( qreal value )
+        { _endValue = value; }
+
+        //* value setter
+        void setTarget( const Setter& setter )
+        { _setter = setter; }
+
+        //* stepping
+        /**
+        when true, progress is digitized to the steps the clock assigns to the animation duration,
+        and unchanged values are not written
+        */
+        void setStepped( bool value )
+        { _stepped = value; }
+
+        //* start from the beginning, in current direction. Does nothing if already running
+        void start( void );
+
+        //* stop
+        void stop( void );
 
         //* restart
         void restart( void )
@@ -56,6 +146,249 @@ namespace Inspire
             start();
         }
 
+        //@}
+
+        protected:
+
+        //* write value
+        virtual void setValue( qreal value )
+        { if( _setter ) _setter( value ); }
+
+        //* called when the animation stops at its end
+        virtual void finish( void )
+        {}
+
+        private:
+
+        friend class AnimationClock;
+
+        //* total duration, negative if looping forever
+        qint64 totalDuration( void ) const
+        { return _loopCount < 0 ? -1 : qint64( _duration )*_loopCount; }
+
+        //* true if time is at the end for current direction
+        bool atEnd( void ) const;
+
+        //* advance time by given amount, write value, and return false once the end is reached
+        bool advance( qint64 elapsed );
+
+        //* write value matching current time
+        void updateValue( void );
+
+        //* duration
+        int _duration = 0;
+
+        //* loop count
+        int _loopCount = 1;
+
+        //* direction
+        Direction _direction = Forward;
+
+        //* values
+        qreal _startValue = 0;
+        qreal _endValue = 1;
+
+        //* setter
+        Setter _setter;
+
+        //* stepping
+        bool _stepped = false;
+
+        //* steps for current duration, zero for continuous values
+        int _stepCount = 0;
+
+        //* last written value
+        qreal _value = 0;
+
+        //* true once a value was written since last start
+        bool _written = false;
+
+        //* time since first loop started
+        qint64 _time = 0;
+
+        //* clock time of last step
+        qint64 _lastStep = 0;
+
+        //* index in the clock running animations, negative when stopped
+        int _index = -1;
+
+    };
+
+    //* animation timeline that notifies when finished
+    class Animation: public QObject, public AnimationTimeline
+    {
+
+        Q_OBJECT
+
+        public:
+
+        //* convenience
+        using Pointer = WeakPointer<Animation>;
+
+        //* constructor
+        Animation( int duration, QObject* parent ):
+            QObject( parent ),
+            AnimationTimeline( duration )
+        {}
+
+        //* destructor
+        virtual ~Animation( void ) = default;
+
+        Q_SIGNALS:
+
+        //* emitted when the animation stops at its end
+        void finished( void );
+
+        protected:
+
+        //* emit finished
+        virtual void finish( void )
+        { emit finished(); }
+
+    };
+
+    //* steps all running animations from a single timer
+    /**
+    updates requested while a frame is ticked are accumulated per window,
+    and each window is updated once at the end of the frame
+    */
+    class AnimationClock: public QObject
+    {
+
+        Q_OBJECT
+
+        public:
+
+        //* shared clock
+        static AnimationClock& instance( void );
+
+        //* default frame interval (ms), when screen refresh rate is unknown
+        static const int FrameInterval = 16;
+
+        //* frame interval (ms), matching screen refresh rate
+        int frameInterval( void ) const
+        { return _frameInterval; }
+
+        //*@name steps
+        //@{
+
+        //* maximum number of distinct values written by stepped animations, zero for continuous values
+        void setSteps( int value )
+        { _steps = value; }
+
+        //* maximum number of distinct values written by stepped animations
+        int steps( void ) const
+        { return _steps; }
+
+        //* steps for an animation of given duration
+        /**
+        no more than the frames it spans at the current frame interval.
+        It divides steps(), so that values remain multiples of 1/steps()
+        */
+        int steps( int duration ) const;
+
+        //@}
+
+        //* counters
+        struct Statistics
+        {
+            //* frames ticked
+            quint64 frames = 0;
+
+            //* animation steps, summed over frames
+            quint64 steps = 0;
+
+            //* updates requested while ticking frames
+            quint64 requests = 0;
+
+            //* updates issued at the end of frames. The others were merged
+            quint64 updates = 0;
+
+            //* values written by stepped animations
+            quint64 writes = 0;
+
+            //* values not written by stepped animations because unchanged, each one a repaint avoided
+            quint64 skippedWrites = 0;
+        };
+
+        //* statistics
+        const Statistics& statistics( void ) const
+        { return _statistics; }
+
+        //* running animations
+        int runningCount( void ) const
+        { return _running.size(); }
+
+        //* schedule widget update
+        void update( QWidget* widget )
+        { update( widget, widget->rect() ); }
+
+        //* schedule update of widget rect. While a frame is ticked, it is merged with other damage of the same window
+        void update( QWidget*, const QRect& );
+
+        protected:
+
+        //* tick
+        virtual void timerEvent( QTimerEvent* );
+
+        private:
+
+        //* constructor
+        explicit AnimationClock( QObject* parent = nullptr ):
+            QObject( parent )
+        { _elapsed.start(); }
+
+        friend class AnimationTimeline;
+
+        //* add running animation
+        void registerAnimation( AnimationTimeline* );
+
+        //* remove running animation
+        void unregisterAnimation( AnimationTimeline* );
+
+        //* update frame interval from screen refresh rate
+        void updateFrameInterval( void );
+
+        //* timer
+        QBasicTimer _timer;
+
+        //* frame interval (ms)
+        int _frameInterval = FrameInterval;
+
+        //* steps
+        int _steps = 0;
+
+        //* monotonic time
+        QElapsedTimer _elapsed;
+
+        //* running animations
+        QVector<AnimationTimeline*> _running;
+
+        //* animations that reached their end during the current frame
+        QVector<AnimationTimeline*> _finished;
+
+        //* damage to flush at the end of the frame
+        struct Damage
+        {
+            //* widget to update, usually a window
+            WeakPointer<QWidget> widget;
+
+            //* region, in widget coordinates
+            QRegion region;
+        };
+
+        //* pending damage
+        QVector<Damage> _damage;
+
+        //* index of pending damage, per widget
+        QHash<const QWidget*, int> _damageIndex;
+
+        //* true while a frame is ticked
+        bool _ticking = false;
+
+        //* statistics
+        Statistics _statistics;
+
     };
 
 }
@@ -23,17 +23,16 @@ namespace Inspire
 {
 
     const qreal AnimationData::OpacityInvalid = -1;
-    int AnimationData::_steps = 0;
 
     //_________________________________________________________________________________
-    void AnimationData::setupAnimation( const Animation::Pointer& animation, const QByteArray& property )
+    void AnimationData::setupAnimation( const Animation::Pointer& animation, const Animation::Setter& setter )
     {
 
         // setup animation
         animation.data()->setStartValue( 0.0 );
         animation.data()->setEndValue( 1.0 );
-        animation.data()->setTargetObject( this );
-        animation.data()->setPropertyName( property );
+        animation.data()->setTarget( setter );
+        animation.data()->setStepped( true );
 
     }
 
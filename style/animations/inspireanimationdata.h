@@ -55,7 +55,15 @@ namespace Inspire
 
         //* steps
         static void setSteps( int value )
-        { _steps = value; }
+        { AnimationClock::instance().setSteps( value ); }
+
+        //* steps
+        /**
+        digitized values are multiples of 1/steps, when steps is positive.
+        Animations use fewer steps when short, see AnimationClock::steps
+        */
+        static int steps( void )
+        { return AnimationClock::instance().steps(); }
 
         //* enability
         virtual bool enabled( void ) const
@@ -75,18 +83,28 @@ namespace Inspire
         protected:
 
         //* setup animation
-        virtual void setupAnimation( const Animation::Pointer& animation, const QByteArray& property );
+        virtual void setupAnimation( const Animation::Pointer& animation, const Animation::Setter& setter );
+
+        //* setup animation, writing its value with given member setter
+        template< typename T >
+        void setupAnimation( const Animation::Pointer& animation, void (T::*setter)( qreal ) )
+        {
+            T* object( static_cast<T*>( this ) );
+            setupAnimation( animation, [object, setter]( qreal value ) { (object->*setter)( value ); } );
+        }
 
         //* apply step
+        /** values already digitized by the animation are left unchanged, up to rounding errors */
         virtual qreal digitize( const qreal& value ) const
         {
-            if( _steps > 0 ) return std::floor( value*_steps )/_steps;
+            const int steps( AnimationData::steps() );
+            if( steps > 0 ) return std::floor( value*steps + 1e-3 )/steps;
             else return value;
         }
 
-        //* trigger target update
+        //* trigger target update, once per animation frame
         virtual void setDirty( void ) const
-        { if( _target ) _target.data()->update(); }
+        { if( _target ) AnimationClock::instance().update( _target.data() ); }
 
         private:
 
@@ -96,9 +114,6 @@ namespace Inspire
         //* enability
         bool _enabled;
 
-        //* steps
-        static int _steps;
-
     };
 
 }
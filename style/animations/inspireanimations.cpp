@@ -18,6 +18,7 @@
  *************************************************************************/
 
 #include "inspireanimations.h"
+#include "inspirewidgetkind.h"
 
 #include <QAbstractItemView>
 #include <QComboBox>
@@ -111,20 +112,21 @@ namespace Inspire
         _widgetEnabilityEngine->registerWidget( widget, AnimationEnable );
 
         // install animation timers
-        // for optimization, one should put with most used widgets here first
+        // widget kinds are cached per class, most used widgets come first
+        const WidgetKinds kinds( widgetKinds( widget ) );
 
         // buttons
-        if( qobject_cast<QToolButton*>(widget) )
+        if( kinds & KindToolButton )
         {
 
             _toolButtonEngine->registerWidget( widget, AnimationHover|AnimationPressed );
             _widgetStateEngine->registerWidget( widget, AnimationHover|AnimationPressed );
 
-        } else if( qobject_cast<QCheckBox*>(widget) || qobject_cast<QRadioButton*>(widget) ) {
+        } else if( kinds & (KindCheckBox|KindRadioButton) ) {
 
             _widgetStateEngine->registerWidget( widget, AnimationHover|AnimationFocus|AnimationPressed );
 
-        } else if( qobject_cast<QAbstractButton*>(widget) ) {
+        } else if( kinds & KindAbstractButton ) {
 
             // register to toolbox engine if needed
             if( qobject_cast<QToolBox*>( widget->parent() ) )
@@ -135,59 +137,58 @@ namespace Inspire
         }
 
         // groupboxes
-        else if( QGroupBox* groupBox = qobject_cast<QGroupBox*>( widget ) )
+        else if( kinds & KindGroupBox )
         {
-            if( groupBox->isCheckable() )
+            if( static_cast<QGroupBox*>( widget )->isCheckable() )
             { _widgetStateEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
         }
 
         // sliders
-        else if( qobject_cast<QScrollBar*>( widget ) ) { _scrollBarEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
-        else if( qobject_cast<QSlider*>( widget ) ) { _widgetStateEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
-        else if( qobject_cast<QDial*>( widget ) ) { _dialEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
+        else if( kinds & KindScrollBar ) { _scrollBarEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
+        else if( kinds & KindSlider ) { _widgetStateEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
+        else if( kinds & KindDial ) { _dialEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
 
         // progress bar
-        else if( qobject_cast<QProgressBar*>( widget ) ) { _busyIndicatorEngine->registerWidget( widget ); }
+        else if( kinds & KindProgressBar ) { _busyIndicatorEngine->registerWidget( widget ); }
 
         // combo box
-        else if( qobject_cast<QComboBox*>( widget ) ) {
+        else if( kinds & KindComboBox ) {
             _comboBoxEngine->registerWidget( widget, AnimationHover|AnimationPressed );
             _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus|AnimationPressed );
         }
 
         // spinbox
-        else if( qobject_cast<QAbstractSpinBox*>( widget ) ) {
+        else if( kinds & KindAbstractSpinBox ) {
             _spinBoxEngine->registerWidget( widget );
             _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus|AnimationPressed );
         }
 
         // editors
-        else if( qobject_cast<QLineEdit*>( widget ) ) { _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
-        else if( qobject_cast<QTextEdit*>( widget ) ) { _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
-        else if( widget->inherits( "KTextEditor::View" ) ) { _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
+        else if( kinds & (KindLineEdit|KindTextEdit|KindTextEditorView) ) { _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
 
         // header views
         // need to come before abstract item view, otherwise is skipped
-        else if( qobject_cast<QHeaderView*>( widget ) ) { _headerViewEngine->registerWidget( widget ); }
+        else if( kinds & KindHeaderView ) { _headerViewEngine->registerWidget( widget ); }
 
         // lists
-        else if( qobject_cast<QAbstractItemView*>( widget ) )
+        else if( kinds & KindAbstractItemView )
         { _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
 
         // tabbar
-        else if( qobject_cast<QTabBar*>( widget ) ) { _tabBarEngine->registerWidget( widget ); }
+        else if( kinds & KindTabBar ) { _tabBarEngine->registerWidget( widget ); }
 
         // scrollarea
-        else if( QAbstractScrollArea* scrollArea = qobject_cast<QAbstractScrollArea*>( widget ) ) {
+        else if( kinds & KindAbstractScrollArea ) {
 
+            QAbstractScrollArea* scrollArea = static_cast<QAbstractScrollArea*>( widget );
             if( scrollArea->frameShadow() == QFrame::Sunken && (widget->focusPolicy()&Qt::StrongFocus) )
             { _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
 
         }
 
         // stacked widgets
-        if( QStackedWidget* stack = qobject_cast<QStackedWidget*>( widget ) )
-        { _stackedWidgetEngine->registerWidget( stack ); }
+        if( kinds & KindStackedWidget )
+        { _stackedWidgetEngine->registerWidget( static_cast<QStackedWidget*>( widget ) ); }
 
         return;
 
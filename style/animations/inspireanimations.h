@@ -105,6 +105,10 @@ namespace Inspire
         ToolBoxEngine& toolBoxEngine( void ) const
         { return *_toolBoxEngine; }
 
+        //* shared clock, stepping the animations of all engines
+        const AnimationClock& clock( void ) const
+        { return AnimationClock::instance(); }
+
         //* setup engines
         void setupEngines( void );
 
@@ -95,8 +95,7 @@ namespace Inspire
                     // setup
                     _animation.data()->setStartValue( 0.0 );
                     _animation.data()->setEndValue( 100.0 );
-                    _animation.data()->setTargetObject( this );
-                    _animation.data()->setPropertyName( "value" );
+                    _animation.data()->setTarget( [this]( qreal value ) { setValue( qRound( value ) ); } );
                     _animation.data()->setLoopCount( -1 );
                     _animation.data()->setDuration( duration() * 3);
 
@@ -117,7 +116,7 @@ namespace Inspire
 
     //____________________________________________________________
     DataMap<BusyIndicatorData>::Value BusyIndicatorEngine::data( const QObject* object )
-    { return _data.find( object ).data(); }
+    { return _data.find( object ); }
 
     //_______________________________________________
     void BusyIndicatorEngine::setValue( int value )
@@ -23,53 +23,219 @@
 #include "inspire.h"
 
 #include <QObject>
-#include <QMap>
 #include <QPaintDevice>
+#include <QVector>
 
 namespace Inspire
 {
 
+    //* data slot, shared by data map and handles
+    template< typename T > struct DataSlot
+    {
+        //* value, null when free
+        T* value = nullptr;
+
+        //* incremented each time the slot is freed
+        quint32 generation = 0;
+    };
+
+    //* weak handle to data map value
+    /**
+    it stays valid until the value is unregistered, which increments its slot generation.
+    The map must outlive its handles
+    */
+    template< typename T > class DataHandle
+    {
+
+        public:
+
+        //* constructor
+        DataHandle( void ) = default;
+
+        //* constructor
+        DataHandle( const QVector< DataSlot<T> >* slots, int index ):
+            _slots( slots ),
+            _index( index ),
+            _generation( slots->constData()[index].generation )
+        {}
+
+        //* value, or null if unregistered
+        T* data( void ) const
+        {
+            if( !_slots ) return nullptr;
+            const DataSlot<T>& slot( _slots->constData()[_index] );
+            return slot.generation == _generation ? slot.value : nullptr;
+        }
+
+        //* validity
+        explicit operator bool( void ) const
+        { return data(); }
+
+        //* clear
+        void clear( void )
+        { _slots = nullptr; }
+
+        private:
+
+        //* slots
+        const QVector< DataSlot<T> >* _slots = nullptr;
+
+        //* index
+        int _index = 0;
+
+        //* generation
+        quint32 _generation = 0;
+
+    };
+
     //* data map
-    /** it maps templatized data object to associated object */
-    template< typename K, typename T > class BaseDataMap: public QMap< const K*, WeakPointer<T> >
+    /**
+    it maps templatized data object to associated object.
+    Keys are stored in an open addressing table with linear probing,
+    values in slots that never move, so that handles survive rehashing
+    */
+    template< typename K, typename T > class BaseDataMap
     {
 
         public:
 
         using Key = const K*;
-        using Value = WeakPointer<T>;
+        using Value = DataHandle<T>;
 
         //* constructor
-        BaseDataMap( void ):
-            QMap<Key, Value>(),
-            _enabled( true ),
-            _lastKey( NULL )
-        {}
+        BaseDataMap( void ) = default;
 
         //* destructor
         virtual ~BaseDataMap( void )
         {}
 
+        //* iterator over registered keys and values
+        class iterator
+        {
+
+            public:
+
+            //* key
+            Key key( void ) const
+            { return _map->_buckets.constData()[_index].key; }
+
+            //* value
+            Value value( void ) const
+            { return Value( &_map->_slots, _map->_buckets.constData()[_index].slot ); }
+
+            //* value
+            Value operator*( void ) const
+            { return value(); }
+
+            //* next registered key
+            iterator& operator++( void )
+            {
+                ++_index;
+                skipEmpty();
+                return *this;
+            }
+
+            //* equality
+            bool operator==( const iterator& other ) const
+            { return _index == other._index; }
+
+            //* inequality
+            bool operator!=( const iterator& other ) const
+            { return _index != other._index; }
+
+            private:
+
+            friend class BaseDataMap;
+
+            //* constructor
+            iterator( const BaseDataMap* map, int index ):
+                _map( map ),
+                _index( index )
+            { skipEmpty(); }
+
+            //* move to next used bucket
+            void skipEmpty( void )
+            { while( _index < _map->_buckets.size() && !_map->_buckets.constData()[_index].key ) ++_index; }
+
+            //* map
+            const BaseDataMap* _map;
+
+            //* bucket index
+            int _index;
+
+        };
+
+        using const_iterator = iterator;
+
+        //*@name iteration
+        //@{
+
+        iterator begin( void ) const
+        { return iterator( this, 0 ); }
+
+        iterator end( void ) const
+        { return iterator( this, _buckets.size() ); }
+
+        //@}
+
+        //* number of registered keys
+        int size( void ) const
+        { return _size; }
+
+        //* true if empty
+        bool isEmpty( void ) const
+        { return _size == 0; }
+
+        //* true if key is registered
+        bool contains( Key key ) const
+        { return key && bucket( key ) >= 0; }
+
         //* insertion
-        virtual typename QMap< Key, Value >::iterator insert( const Key& key, const Value& value, bool enabled = true )
+        /** replaces, without deleting, the value previously associated to key */
+        virtual Value insert( Key key, T* value, bool enabled = true )
         {
-            if( value ) value.data()->setEnabled( enabled );
-            return QMap< Key, Value >::insert( key, value );
+            if( !key ) return Value();
+            if( value ) value->setEnabled( enabled );
+
+            int index( bucket( key ) );
+            if( index >= 0 )
+            {
+                // reuse slot, but invalidate handles to the previous value
+                const int slot( _buckets.constData()[index].slot );
+                ++_slots[slot].generation;
+                _slots[slot].value = value;
+                return Value( &_slots, slot );
+            }
+
+            // keep load factor below one half
+            if( 2*( _size + 1 ) > _buckets.size() ) rehash( qMax( 16, 2*_buckets.size() ) );
+
+            // store value
+            int slot;
+            if( _freeSlots.isEmpty() )
+            {
+                slot = _slots.size();
+                _slots.append( DataSlot<T>() );
+
+            } else slot = _freeSlots.takeLast();
+
+            _slots[slot].value = value;
+
+            // store key
+            for( index = hash( key ); _buckets.constData()[index].key; index = ( index + 1 )&_mask ) {}
+            _buckets[index].key = key;
+            _buckets[index].slot = slot;
+            ++_size;
+
+            return Value( &_slots, slot );
         }
 
         //* find value
-        Value find( Key key )
+        Value find( Key key ) const
         {
             if( !( enabled() && key ) ) return Value();
-            if( key == _lastKey ) return _lastValue;
-            else {
-                Value out;
-                typename QMap<Key, Value>::iterator iter( QMap<Key, Value>::find( key ) );
-                if( iter != QMap<Key, Value>::end() ) out = iter.value();
-                _lastKey = key;
-                _lastValue = out;
-                return out;
-            }
+            const int index( bucket( key ) );
+            return index >= 0 ? Value( &_slots, _buckets.constData()[index].slot ) : Value();
         }
 
         //* unregister widget
@@ -79,22 +245,30 @@ namespace Inspire
             // check key
             if( !key ) return false;
 
-            // clear last value if needed
-            if( key == _lastKey )
-            {
+            // find key in table
+            int index( bucket( key ) );
+            if( index < 0 ) return false;
 
-                if( _lastValue ) _lastValue.clear();
-                _lastKey = NULL;
+            // delete value if found, and invalidate handles
+            DataSlot<T>& slot( _slots[_buckets.constData()[index].slot] );
+            if( slot.value ) slot.value->deleteLater();
+            slot.value = nullptr;
+            ++slot.generation;
+            _freeSlots.append( _buckets.constData()[index].slot );
 
+            // shift following keys back, so that probing needs no tombstone
+            for( int next = ( index + 1 )&_mask; _buckets.constData()[next].key; next = ( next + 1 )&_mask )
+            {
+                const int ideal( hash( _buckets.constData()[next].key ) );
+                if( ( ( next - ideal )&_mask ) >= ( ( next - index )&_mask ) )
+                {
+                    _buckets[index] = _buckets.constData()[next];
+                    index = next;
+                }
             }
 
-            // find key in map
-            typename QMap<Key, Value>::iterator iter( QMap<Key, Value>::find( key ) );
-            if( iter == QMap<Key, Value>::end() ) return false;
-
-            // delete value from map if found
-            if( iter.value() ) iter.value().data()->deleteLater();
-            QMap<Key, Value>::erase( iter );
+            _buckets[index] = Bucket();
+            --_size;
 
             return true;
 
@@ -104,8 +278,8 @@ namespace Inspire
         void setEnabled( bool enabled )
         {
             _enabled = enabled;
-            foreach( const Value& value, *this )
-            { if( value ) value.data()->setEnabled( enabled ); }
+            for( const DataSlot<T>& slot : _slots )
+            { if( slot.value ) slot.value->setEnabled( enabled ); }
         }
 
         //* enability
@@ -115,20 +289,78 @@ namespace Inspire
         //* duration
         void setDuration( int duration ) const
         {
-            foreach( const Value& value, *this )
-            { if( value ) value.data()->setDuration( duration ); }
+            for( const DataSlot<T>& slot : _slots )
+            { if( slot.value ) slot.value->setDuration( duration ); }
         }
 
         private:
 
+        Q_DISABLE_COPY( BaseDataMap )
+
+        //* table bucket
+        struct Bucket
+        {
+            //* key, null when empty
+            Key key = nullptr;
+
+            //* value slot
+            int slot = 0;
+        };
+
+        //* ideal bucket for key
+        int hash( Key key ) const
+        { return int( ( quint64( quintptr( key ) )*Q_UINT64_C( 0x9E3779B97F4A7C15 ) ) >> _shift ); }
+
+        //* bucket holding key, or -1
+        int bucket( Key key ) const
+        {
+            if( _buckets.isEmpty() ) return -1;
+            for( int index = hash( key );; index = ( index + 1 )&_mask )
+            {
+                const Bucket& bucket( _buckets.constData()[index] );
+                if( bucket.key == key ) return index;
+                else if( !bucket.key ) return -1;
+            }
+        }
+
+        //* resize table and reinsert keys. Slots do not move
+        void rehash( int capacity )
+        {
+            const QVector<Bucket> buckets( _buckets );
+            _buckets = QVector<Bucket>( capacity );
+            _mask = capacity - 1;
+            _shift = 64;
+            for( int value = capacity; value > 1; value >>= 1 ) --_shift;
+
+            for( const Bucket& bucket : buckets )
+            {
+                if( !bucket.key ) continue;
+                int index( hash( bucket.key ) );
+                while( _buckets.constData()[index].key ) index = ( index + 1 )&_mask;
+                _buckets[index] = bucket;
+            }
+        }
+
         //* enability
-        bool _enabled;
+        bool _enabled = true;
+
+        //* buckets, power of two sized
+        QVector<Bucket> _buckets;
+
+        //* bucket mask
+        int _mask = 0;
+
+        //* hash shift, keeps the bits matching bucket count
+        int _shift = 64;
+
+        //* number of keys
+        int _size = 0;
 
-        //* last key
-        Key _lastKey;
+        //* values
+        QVector< DataSlot<T> > _slots;
 
-        //* last value
-        Value _lastValue;
+        //* free value slots
+        QVector<int> _freeSlots;
 
     };
 
@@ -33,7 +33,7 @@ namespace Inspire
 
         // only handle hover and focus
         if( mode&AnimationHover && !dataMap(AnimationHover).contains( widget ) ) { dataMap(AnimationHover).insert( widget, new DialData( this, widget, duration() ), enabled() ); }
-        if( mode&AnimationFocus && !dataMap(AnimationFocus).contains( widget ) ) { dataMap(AnimationFocus).insert( widget, new WidgetStateData( this, widget, duration() ), enabled() ); }
+        if( mode&AnimationFocus ) WidgetStateEngine::registerWidget( widget, AnimationFocus );
 
         // connect destruction signal
         connect( widget, SIGNAL(destroyed(QObject*)), this, SLOT(unregisterWidget(QObject*)), Qt::UniqueConnection );
@@ -29,6 +29,6 @@ namespace Inspire
         AnimationData( parent, target ),
         _animation( new Animation( duration, this ) ),
         _opacity(0)
-    { setupAnimation( _animation, "opacity" ); }
+    { setupAnimation( _animation, &GenericData::setOpacity ); }
 
 }
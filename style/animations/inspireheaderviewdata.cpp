@@ -57,11 +57,11 @@ namespace Inspire
     {
 
         _current._animation = new Animation( duration, this );
-        setupAnimation( currentIndexAnimation(), "currentOpacity" );
+        setupAnimation( currentIndexAnimation(), &HeaderViewData::setCurrentOpacity );
         currentIndexAnimation().data()->setDirection( Animation::Forward );
 
         _previous._animation = new Animation( duration, this );
-        setupAnimation( previousIndexAnimation(), "previousOpacity" );
+        setupAnimation( previousIndexAnimation(), &HeaderViewData::setPreviousOpacity );
         previousIndexAnimation().data()->setDirection( Animation::Backward );
 
     }
@@ -164,8 +164,8 @@ namespace Inspire
         int right = header->sectionViewportPosition( lastIndex ) + header->sectionSize( lastIndex );
 
         // trigger update
-        if( header->orientation() == Qt::Horizontal ) viewport->update( left, 0, right-left, header->height() );
-        else viewport->update( 0, left, header->width(), right-left );
+        if( header->orientation() == Qt::Horizontal ) AnimationClock::instance().update( viewport, QRect( left, 0, right-left, header->height() ) );
+        else AnimationClock::instance().update( viewport, QRect( 0, left, header->width(), right-left ) );
 
     }
 
@@ -44,9 +44,9 @@ namespace Inspire
         connect( subLineAnimation().data(), SIGNAL(finished()), SLOT(clearSubLineRect()) );
 
         // setup animation
-        setupAnimation( addLineAnimation(), "addLineOpacity" );
-        setupAnimation( subLineAnimation(), "subLineOpacity" );
-        setupAnimation( grooveAnimation(), "grooveOpacity" );
+        setupAnimation( addLineAnimation(), &ScrollBarData::setAddLineOpacity );
+        setupAnimation( subLineAnimation(), &ScrollBarData::setSubLineOpacity );
+        setupAnimation( grooveAnimation(), &ScrollBarData::setGrooveOpacity );
 
     }
 
@@ -30,10 +30,10 @@ namespace Inspire
         _downArrowData._hoverAnimation = new Animation( duration, this );
         _upArrowData._pressedAnimation = new Animation( duration, this );
         _downArrowData._pressedAnimation = new Animation( duration, this );
-        setupAnimation( upArrowAnimation(), "upArrowOpacity" );
-        setupAnimation( downArrowAnimation(), "downArrowOpacity" );
-        setupAnimation( upArrowPressedAnimation(), "upArrowPressed" );
-        setupAnimation( downArrowPressedAnimation(), "downArrowPressed" );
+        setupAnimation( upArrowAnimation(), &SpinBoxData::setUpArrowOpacity );
+        setupAnimation( downArrowAnimation(), &SpinBoxData::setDownArrowOpacity );
+        setupAnimation( upArrowPressedAnimation(), &SpinBoxData::setUpArrowPressed );
+        setupAnimation( downArrowPressedAnimation(), &SpinBoxData::setDownArrowPressed );
     }
 
     //______________________________________________
@@ -75,7 +75,7 @@ namespace Inspire
             transition().data()->setOpacity( 0 );
             startClock();
             transition().data()->setGeometry( widget->geometry() );
-            transition().data()->setStartPixmap( transition().data()->grab( widget ) );
+            transition().data()->grabStart( widget );
 
             _index = _target.data()->currentIndex();
             return !slow();
@@ -62,8 +62,8 @@ namespace Inspire
 
         switch( mode )
         {
-            case AnimationHover: return _hoverData.find( object ).data();
-            case AnimationFocus: return _focusData.find( object ).data();
+            case AnimationHover: return _hoverData.find( object );
+            case AnimationFocus: return _focusData.find( object );
             default: return DataMap<TabBarData>::Value();
         }
 
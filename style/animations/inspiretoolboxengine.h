@@ -89,7 +89,7 @@ namespace Inspire
 
         //* returns data associated to widget
         PaintDeviceDataMap<WidgetStateData>::Value data( const QPaintDevice* object )
-        { return _data.find( object ).data(); }
+        { return _data.find( object ); }
 
         private:
 
@@ -40,6 +40,55 @@ namespace Inspire
     { return _paintEnabled; }
 
     int TransitionWidget::_steps = 0;
+    bool TransitionWidget::_imageBackend = false;
+
+    //________________________________________________
+    //* resize offscreen buffers, when needed
+    static void resizeBuffer( QPixmap& pixmap, const QSize& size )
+    { if( pixmap.isNull() || pixmap.size() != size ) pixmap = QPixmap( size ); }
+
+    static void resizeBuffer( QImage& image, const QSize& size )
+    { if( image.isNull() || image.size() != size ) image = QImage( size, QImage::Format_ARGB32_Premultiplied ); }
+
+    //________________________________________________
+    //* draw buffer at origin
+    static void drawBuffer( QPainter& painter, const QPixmap& pixmap )
+    { painter.drawPixmap( QPoint(0,0), pixmap ); }
+
+    static void drawBuffer( QPainter& painter, const QImage& image )
+    { painter.drawImage( QPoint(0,0), image ); }
+
+    //________________________________________________
+    //* fade source into target
+    template<typename T> static void fadeBuffer( const T& source, T& target, const QSize& size, qreal opacity, const QRect& rect )
+    {
+
+        resizeBuffer( target, size );
+
+        // erase target
+        target.fill( Qt::transparent );
+
+        // check opacity
+        if( opacity*255 < 1 ) return;
+
+        QPainter p( &target );
+        p.setClipRect( rect );
+
+        // draw source
+        drawBuffer( p, source );
+
+        // opacity mask (0.996 corresponds to 254/255)
+        if( opacity <= 0.996 )
+        {
+            p.setCompositionMode(QPainter::CompositionMode_DestinationIn);
+            QColor color( Qt::black );
+            color.setAlphaF( opacity );
+            p.fillRect(rect, color );
+        }
+
+        p.end();
+
+    }
 
     //________________________________________________
     TransitionWidget::TransitionWidget( QWidget* parent, int duration ):
@@ -54,8 +103,7 @@ namespace Inspire
         // setup animation
         _animation.data()->setStartValue( 0 );
         _animation.data()->setEndValue( 1.0 );
-        _animation.data()->setTargetObject( this );
-        _animation.data()->setPropertyName( "opacity" );
+        _animation.data()->setTarget( [this]( qreal value ) { setOpacity( value ); } );
 
         // hide when animation is finished
         connect( _animation.data(), SIGNAL(finished()), SLOT(hide()) );
@@ -70,9 +118,7 @@ namespace Inspire
         if( !rect.isValid() ) rect = widget->rect();
         if( !rect.isValid() ) return QPixmap();
 
-        // initialize pixmap
-        QPixmap out( rect.size() );
-        out.fill( Qt::transparent );
+        QPixmap out;
         _paintEnabled = false;
 
         if( testFlag( GrabFromWindow ) )
@@ -86,6 +132,42 @@ namespace Inspire
             out = widget->grab( rect );
             #endif
 
+        } else {
+
+            out = QPixmap( rect.size() );
+            out.fill( Qt::transparent );
+            if( !testFlag( Transparent ) ) { grabBackground( out, widget, rect ); }
+            grabWidget( out, widget, rect );
+
+        }
+
+        _paintEnabled = true;
+
+        return out;
+
+    }
+
+    //________________________________________________
+    QImage TransitionWidget::grabImage( QWidget* widget, QRect rect )
+    {
+
+        // change rect
+        if( !rect.isValid() ) rect = widget->rect();
+        if( !rect.isValid() ) return QImage();
+
+        // initialize image
+        QImage out( rect.size(), QImage::Format_ARGB32_Premultiplied );
+        out.fill( Qt::transparent );
+        _paintEnabled = false;
+
+        if( testFlag( GrabFromWindow ) )
+        {
+
+            // same as QWidget::grab, rendered directly to the image
+            rect = rect.translated( widget->mapTo( widget->window(), widget->rect().topLeft() ) );
+            widget = widget->window();
+            widget->render( &out, QPoint(), rect, QWidget::DrawWindowBackground | QWidget::DrawChildren );
+
         } else {
 
             if( !testFlag( Transparent ) ) { grabBackground( out, widget, rect ); }
@@ -122,89 +204,93 @@ namespace Inspire
     void TransitionWidget::paintEvent( QPaintEvent* event )
     {
 
-        // fully transparent case
-        if( opacity() >= 1.0 && endPixmap().isNull() ) return;
         if( !_paintEnabled ) return;
+        if( _imageBackend ) paintBuffers( event, _startImage, _endImage, _currentImage, _localStartImage );
+        else paintBuffers( event, _startPixmap, _endPixmap, _currentPixmap, _localStartPixmap );
+
+    }
+
+    //________________________________________________
+    template< typename T >
+    void TransitionWidget::paintBuffers( QPaintEvent* event, const T& start, const T& end, T& current, T& localStart )
+    {
+
+        // fully transparent case
+        if( opacity() >= 1.0 && end.isNull() ) return;
 
         // get rect
         QRect rect = event->rect();
         if( !rect.isValid() ) rect = this->rect();
 
-        // local pixmap
+        // local buffer
         bool paintOnWidget( testFlag( PaintOnWidget ) && !testFlag( Transparent ) );
-        if( !paintOnWidget )
-        {
-
-            if( _currentPixmap.isNull() || _currentPixmap.size() != size() )
-            { _currentPixmap = QPixmap( size() ); }
-
-        }
+        if( !paintOnWidget ) resizeBuffer( current, size() );
 
         // fill
-        _currentPixmap.fill( Qt::transparent );
+        current.fill( Qt::transparent );
 
-        // copy local pixmap to current
+        // copy local buffer to current
         {
 
             QPainter p;
 
-            // draw end pixmap first, provided that opacity is small enough
-            if( opacity() >= 0.004 && !_endPixmap.isNull() )
+            // draw end buffer first, provided that opacity is small enough
+            if( opacity() >= 0.004 && !end.isNull() )
             {
 
-                // faded endPixmap if parent target is transparent and opacity is
+                // faded end buffer if parent target is transparent and opacity is
                 if( opacity() <= 0.996 && testFlag( Transparent ) )
                 {
 
-                    fade( _endPixmap, _currentPixmap, opacity(), rect );
-                    p.begin( &_currentPixmap );
+                    fade( end, current, opacity(), rect );
+                    p.begin( &current );
                     p.setClipRect( event->rect() );
 
                 } else {
 
                     if( paintOnWidget ) p.begin( this );
-                    else p.begin( &_currentPixmap );
+                    else p.begin( &current );
                     p.setClipRect( event->rect() );
-                    p.drawPixmap( QPoint(), _endPixmap );
+                    drawBuffer( p, end );
 
                 }
 
             } else {
 
                 if( paintOnWidget ) p.begin( this );
-                else p.begin( &_currentPixmap );
+                else p.begin( &current );
                 p.setClipRect( event->rect() );
 
             }
 
-            // draw fading start pixmap
-            if( opacity() <= 0.996 && !_startPixmap.isNull() )
+            // draw fading start buffer
+            if( opacity() <= 0.996 && !start.isNull() )
             {
                 if( opacity() >= 0.004 )
                 {
 
-                    fade( _startPixmap, _localStartPixmap, 1.0-opacity(), rect );
-                    p.drawPixmap( QPoint(), _localStartPixmap );
+                    fade( start, localStart, 1.0-opacity(), rect );
+                    drawBuffer( p, localStart );
 
-                } else p.drawPixmap( QPoint(), _startPixmap );
+                } else drawBuffer( p, start );
 
             }
 
             p.end();
         }
 
-        // copy current pixmap on widget
+        // copy current buffer on widget
         if( !paintOnWidget )
         {
             QPainter p( this );
             p.setClipRect( event->rect() );
-            p.drawPixmap( QPoint(0,0), _currentPixmap );
+            drawBuffer( p, current );
             p.end();
         }
     }
 
     //________________________________________________
-    void TransitionWidget::grabBackground( QPixmap& pixmap, QWidget* widget, QRect& rect ) const
+    void TransitionWidget::grabBackground( QPaintDevice& device, QWidget* widget, QRect& rect ) const
     {
         if( !widget ) return;
 
@@ -231,7 +317,7 @@ namespace Inspire
         if( !parent ) parent = widget;
 
         // painting
-        QPainter p(&pixmap);
+        QPainter p(&device);
         p.setClipRect( rect );
         QBrush backgroundBrush = parent->palette().brush( parent->backgroundRole());
         if( backgroundBrush.style() == Qt::TexturePattern)
@@ -241,7 +327,7 @@ namespace Inspire
 
         } else {
 
-            p.fillRect( pixmap.rect(), backgroundBrush );
+            p.fillRect( QRect( 0, 0, device.width(), device.height() ), backgroundBrush );
 
         }
 
@@ -271,39 +357,15 @@ namespace Inspire
     }
 
     //________________________________________________
-    void TransitionWidget::grabWidget( QPixmap& pixmap, QWidget* widget, QRect& rect ) const
-    { widget->render( &pixmap, pixmap.rect().topLeft(), rect, QWidget::DrawChildren ); }
+    void TransitionWidget::grabWidget( QPaintDevice& device, QWidget* widget, QRect& rect ) const
+    { widget->render( &device, QPoint(), rect, QWidget::DrawChildren ); }
 
     //________________________________________________
     void TransitionWidget::fade( const QPixmap& source, QPixmap& target, qreal opacity, const QRect& rect ) const
-    {
-
-        if( target.isNull() || target.size() != size() )
-        { target = QPixmap( size() ); }
-
-        // erase target
-        target.fill( Qt::transparent );
-
-        // check opacity
-        if( opacity*255 < 1 ) return;
-
-        QPainter p( &target );
-        p.setClipRect( rect );
-
-        // draw pixmap
-        p.drawPixmap( QPoint(0,0), source );
+    { fadeBuffer( source, target, size(), opacity, rect ); }
 
-        // opacity mask (0.996 corresponds to 254/255)
-        if( opacity <= 0.996 )
-        {
-            p.setCompositionMode(QPainter::CompositionMode_DestinationIn);
-            QColor color( Qt::black );
-            color.setAlphaF( opacity );
-            p.fillRect(rect, color );
-        }
-
-        p.end();
-        return;
-    }
+    //________________________________________________
+    void TransitionWidget::fade( const QImage& source, QImage& target, qreal opacity, const QRect& rect ) const
+    { fadeBuffer( source, target, size(), opacity, rect ); }
 
 }
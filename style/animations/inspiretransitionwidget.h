@@ -29,6 +29,7 @@
 #include "inspireanimation.h"
 #include "inspire.h"
 
+#include <QImage>
 #include <QWidget>
 
 #include <cmath>
@@ -97,6 +98,15 @@ namespace Inspire
         static void setSteps( int value )
         { _steps = value; }
 
+        //* offscreen backend
+        /** when true, grabbing and fading are done on QImage rather than QPixmap */
+        static void setImageBackend( bool value )
+        { _imageBackend = value; }
+
+        //* offscreen backend
+        static bool imageBackend( void )
+        { return _imageBackend; }
+
         //*@name opacity
         //@{
 
@@ -108,7 +118,7 @@ namespace Inspire
             value = digitize( value );
             if( _opacity == value ) return;
             _opacity = value;
-            update();
+            AnimationClock::instance().update( this );
         }
 
         //@}
@@ -118,7 +128,10 @@ namespace Inspire
 
         //* start
         void resetStartPixmap( void )
-        { setStartPixmap( QPixmap() ); }
+        {
+            setStartPixmap( QPixmap() );
+            setStartImage( QImage() );
+        }
 
         //* start
         void setStartPixmap( QPixmap pixmap )
@@ -130,7 +143,10 @@ namespace Inspire
 
         //* end
         void resetEndPixmap( void )
-        { setEndPixmap( QPixmap() ); }
+        {
+            setEndPixmap( QPixmap() );
+            setEndImage( QImage() );
+        }
 
         //* end
         void setEndPixmap( QPixmap pixmap )
@@ -149,9 +165,40 @@ namespace Inspire
 
         //@}
 
+        //@name images handling, for image backend
+        //@{
+
+        //* start
+        void setStartImage( QImage image )
+        { _startImage = image; }
+
+        //* start
+        const QImage& startImage( void ) const
+        { return _startImage; }
+
+        //* end
+        void setEndImage( QImage image )
+        { _endImage = image; }
+
+        //* end
+        const QImage& endImage( void ) const
+        { return _endImage; }
+
+        //@}
+
         //* grap pixmap
         QPixmap grab( QWidget* = 0, QRect = QRect() );
 
+        //* grab image
+        QImage grabImage( QWidget* = 0, QRect = QRect() );
+
+        //* grab start pixmap or image, depending on offscreen backend
+        void grabStart( QWidget* widget, QRect rect = QRect() )
+        {
+            if( _imageBackend ) setStartImage( grabImage( widget, rect ) );
+            else setStartPixmap( grab( widget, rect ) );
+        }
+
         //* true if animated
         virtual bool isAnimated( void ) const
         { return _animation.data()->isRunning(); }
@@ -184,14 +231,17 @@ namespace Inspire
         Use home-made grabber instead. This is directly inspired from bespin.
         Copyright (C) 2007 Thomas Luebking <thomas.luebking@web.de>
         */
-        virtual void grabBackground( QPixmap&, QWidget*, QRect& ) const;
+        virtual void grabBackground( QPaintDevice&, QWidget*, QRect& ) const;
 
         //* grab widget
-        virtual void grabWidget( QPixmap&, QWidget*, QRect& ) const;
+        virtual void grabWidget( QPaintDevice&, QWidget*, QRect& ) const;
 
         //* fade pixmap
         virtual void fade( const QPixmap& source, QPixmap& target, qreal opacity, const QRect& ) const;
 
+        //* fade image
+        virtual void fade( const QImage& source, QImage& target, qreal opacity, const QRect& ) const;
+
         //* apply step
         virtual qreal digitize( const qreal& value ) const
         {
@@ -201,6 +251,10 @@ namespace Inspire
 
         private:
 
+        //* paint transition from start and end buffers, using current and local start buffers of the same type
+        template< typename T >
+        void paintBuffers( QPaintEvent*, const T& start, const T& end, T& current, T& localStart );
+
         //* Flags
         Flags _flags = None;
 
@@ -222,12 +276,32 @@ namespace Inspire
         //* current pixmap
         QPixmap _currentPixmap;
 
+        //*@name images, for image backend
+        //@{
+
+        //* animation starting image
+        QImage _startImage;
+
+        //* animation starting image
+        QImage _localStartImage;
+
+        //* animation ending image
+        QImage _endImage;
+
+        //* current image
+        QImage _currentImage;
+
+        //@}
+
         //* current state opacity
         qreal _opacity = 0;
 
         //* steps
         static int _steps;
 
+        //* offscreen backend
+        static bool _imageBackend;
+
     };
 
 }
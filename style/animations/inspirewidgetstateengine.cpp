@@ -20,20 +20,47 @@
 
 #include "inspirewidgetstateengine.h"
 
-#include "inspireenabledata.h"
+#include <QEvent>
 
 namespace Inspire
 {
 
+    //____________________________________________________________
+    void WidgetStateAnimation::setValue( qreal value )
+    {
+        _opacity = value;
+        if( _target ) AnimationClock::instance().update( _target );
+    }
+
+    //____________________________________________________________
+    void WidgetStateAnimation::finish( void )
+    { if( _engine ) _engine->animationFinished( this ); }
+
+    //____________________________________________________________
+    WidgetStateEngine::~WidgetStateEngine( void )
+    {
+        foreach( const Record& record, _records )
+        {
+            for( WidgetStateAnimation* animation : record.animations )
+            { delete animation; }
+        }
+
+        qDeleteAll( _pool );
+    }
+
     //____________________________________________________________
     bool WidgetStateEngine::registerWidget( QWidget* widget, AnimationModes mode )
     {
 
         if( !widget ) return false;
-        if( mode&AnimationHover && !_hoverData.contains( widget ) ) { _hoverData.insert( widget, new WidgetStateData( this, widget, duration() ), enabled() ); }
-        if( mode&AnimationFocus && !_focusData.contains( widget ) ) { _focusData.insert( widget, new WidgetStateData( this, widget, duration() ), enabled() ); }
-        if( mode&AnimationEnable && !_enableData.contains( widget ) ) { _enableData.insert( widget, new EnableData( this, widget, duration() ), enabled() ); }
-        if( mode&AnimationPressed && !_pressedData.contains( widget ) ) { _pressedData.insert( widget, new WidgetStateData( this, widget, duration() ), enabled() ); }
+
+        // animations are only allocated on first state change
+        Record& record( _records[widget] );
+        record.target = widget;
+
+        // enable state changes are followed by the engine itself
+        if( mode&AnimationEnable && !( record.registered&AnimationEnable ) ) widget->installEventFilter( this );
+        record.registered |= mode;
 
         // connect destruction signal
         connect( widget, SIGNAL(destroyed(QObject*)), this, SLOT(unregisterWidget(QObject*)), Qt::UniqueConnection );
@@ -52,28 +79,31 @@ namespace Inspire
 
         if( mode&AnimationHover )
         {
-            foreach( const Value& value, _hoverData )
+            for( const Value& value : _hoverData )
             { if( value ) out.insert( value.data()->target().data() ); }
         }
 
         if( mode&AnimationFocus )
         {
-            foreach( const Value& value, _focusData )
+            for( const Value& value : _focusData )
             { if( value ) out.insert( value.data()->target().data() ); }
         }
 
         if( mode&AnimationEnable )
         {
-            foreach( const Value& value, _enableData )
+            for( const Value& value : _enableData )
             { if( value ) out.insert( value.data()->target().data() ); }
         }
 
         if( mode&AnimationPressed )
         {
-            foreach( const Value& value, _pressedData )
+            for( const Value& value : _pressedData )
             { if( value ) out.insert( value.data()->target().data() ); }
         }
 
+        foreach( const Record& record, _records )
+        { if( record.registered&mode ) out.insert( record.target ); }
+
         return out;
 
     }
@@ -81,16 +111,73 @@ namespace Inspire
     //____________________________________________________________
     bool WidgetStateEngine::updateState( const QObject* object, AnimationMode mode, bool value )
     {
-        DataMap<WidgetStateData>::Value data( WidgetStateEngine::data( object, mode ) );
-        return ( data && data.data()->updateState( value ) );
+
+        // data from derived engines
+        if( DataMap<WidgetStateData>::Value data = WidgetStateEngine::data( object, mode ) )
+        { return data.data()->updateState( value ); }
+
+        if( !( enabled() && object ) ) return false;
+
+        auto iter( _records.find( object ) );
+        if( iter == _records.end() || !( iter->registered&mode ) ) return false;
+
+        Record& record( *iter );
+        const bool changed( bool( record.state&mode ) != value );
+        if( value ) record.state |= mode;
+        else record.state &= ~mode;
+
+        // first state only initializes
+        if( !( record.initialized&mode ) )
+        {
+            record.initialized |= mode;
+            return false;
+        }
+
+        if( !changed ) return false;
+
+        WidgetStateAnimation*& animation( record.animations[animationIndex( mode )] );
+        if( !animation ) animation = allocateAnimation( record.target, mode );
+
+        animation->setDirection( value ? AnimationTimeline::Forward : AnimationTimeline::Backward );
+        if( !animation->isRunning() ) animation->start();
+        return true;
+
+    }
+
+    //____________________________________________________________
+    bool WidgetStateEngine::eventFilter( QObject* object, QEvent* event )
+    {
+
+        if( event->type() == QEvent::EnabledChange && object->isWidgetType() )
+        { updateState( object, AnimationEnable, static_cast<QWidget*>( object )->isEnabled() ); }
+
+        return BaseEngine::eventFilter( object, event );
+
     }
 
     //____________________________________________________________
-    bool WidgetStateEngine::isAnimated( const QObject* object, AnimationMode mode )
+    bool WidgetStateEngine::unregisterWidget( QObject* object )
     {
 
-        DataMap<WidgetStateData>::Value data( WidgetStateEngine::data( object, mode ) );
-        return ( data && data.data()->animation() && data.data()->animation().data()->isRunning() );
+        if( !object ) return false;
+        bool found = false;
+        if( _hoverData.unregisterWidget( object ) ) found = true;
+        if( _focusData.unregisterWidget( object ) ) found = true;
+        if( _enableData.unregisterWidget( object ) ) found = true;
+        if( _pressedData.unregisterWidget( object ) ) found = true;
+
+        auto iter( _records.find( object ) );
+        if( iter != _records.end() )
+        {
+            if( iter->registered&AnimationEnable ) object->removeEventFilter( this );
+            for( WidgetStateAnimation* animation : iter->animations )
+            { if( animation ) recycleAnimation( animation ); }
+
+            _records.erase( iter );
+            found = true;
+        }
+
+        return found;
 
     }
 
@@ -100,10 +187,10 @@ namespace Inspire
 
         switch( mode )
         {
-            case AnimationHover: return _hoverData.find( object ).data();
-            case AnimationFocus: return _focusData.find( object ).data();
-            case AnimationEnable: return _enableData.find( object ).data();
-            case AnimationPressed: return _pressedData.find( object ).data();
+            case AnimationHover: return _hoverData.find( object );
+            case AnimationFocus: return _focusData.find( object );
+            case AnimationEnable: return _enableData.find( object );
+            case AnimationPressed: return _pressedData.find( object );
             default: return DataMap<WidgetStateData>::Value();
         }
 
@@ -125,4 +212,82 @@ namespace Inspire
 
     }
 
+    //____________________________________________________________
+    int WidgetStateEngine::animationIndex( AnimationMode mode )
+    {
+
+        switch( mode )
+        {
+            default:
+            case AnimationHover: return 0;
+            case AnimationFocus: return 1;
+            case AnimationEnable: return 2;
+            case AnimationPressed: return 3;
+        }
+
+    }
+
+    //____________________________________________________________
+    qreal WidgetStateEngine::animationOpacity( const QObject* object, AnimationMode mode )
+    {
+
+        // data from derived engines
+        if( DataMap<WidgetStateData>::Value data = WidgetStateEngine::data( object, mode ) )
+        {
+            const Animation::Pointer& animation( data.data()->animation() );
+            return ( animation && animation.data()->isRunning() ) ? data.data()->opacity() : AnimationData::OpacityInvalid;
+        }
+
+        if( !( enabled() && object && mode != AnimationNone ) ) return AnimationData::OpacityInvalid;
+
+        auto iter( _records.constFind( object ) );
+        if( iter == _records.constEnd() ) return AnimationData::OpacityInvalid;
+
+        // animations are recycled once finished, so an attached animation is running
+        const WidgetStateAnimation* animation( iter->animations[animationIndex( mode )] );
+        return animation ? animation->opacity() : AnimationData::OpacityInvalid;
+
+    }
+
+    //____________________________________________________________
+    WidgetStateAnimation* WidgetStateEngine::allocateAnimation( QWidget* target, AnimationMode mode )
+    {
+
+        WidgetStateAnimation* animation( _pool.isEmpty() ? new WidgetStateAnimation() : _pool.takeLast() );
+
+        animation->_engine = this;
+        animation->_target = target;
+        animation->_mode = mode;
+        animation->setDuration( mode == AnimationPressed ? duration()/2 : duration() );
+        return animation;
+
+    }
+
+    //____________________________________________________________
+    void WidgetStateEngine::recycleAnimation( WidgetStateAnimation* animation )
+    {
+
+        // detach first, so that stopping does not call back
+        animation->_engine = nullptr;
+        animation->_target = nullptr;
+        animation->stop();
+        _pool.append( animation );
+
+    }
+
+    //____________________________________________________________
+    void WidgetStateEngine::animationFinished( WidgetStateAnimation* animation )
+    {
+
+        auto iter( _records.find( animation->_target ) );
+        if( iter != _records.end() )
+        {
+            WidgetStateAnimation*& current( iter->animations[animationIndex( animation->_mode )] );
+            if( current == animation ) current = nullptr;
+        }
+
+        recycleAnimation( animation );
+
+    }
+
 }
@@ -21,14 +21,65 @@
  *************************************************************************/
 
 #include "inspire.h"
+#include "inspireanimation.h"
 #include "inspirebaseengine.h"
 #include "inspiredatamap.h"
 #include "inspirewidgetstatedata.h"
 
+#include <QHash>
+#include <QVector>
+
 namespace Inspire
 {
 
+    class WidgetStateEngine;
+
+    //* widget state animation, allocated on first state change and recycled by the engine once finished
+    class WidgetStateAnimation: public AnimationTimeline
+    {
+
+        public:
+
+        //* constructor
+        WidgetStateAnimation( void )
+        { setStepped( true ); }
+
+        //* opacity
+        qreal opacity( void ) const
+        { return _opacity; }
+
+        protected:
+
+        //* store opacity and update target. Values are digitized, and only written when changed
+        virtual void setValue( qreal );
+
+        //* return to the engine pool
+        virtual void finish( void );
+
+        private:
+
+        friend class WidgetStateEngine;
+
+        //* engine, reset when recycled
+        WidgetStateEngine* _engine = nullptr;
+
+        //* animated widget
+        QWidget* _target = nullptr;
+
+        //* animation mode
+        AnimationMode _mode = AnimationNone;
+
+        //* opacity
+        qreal _opacity = 0;
+
+    };
+
     //* used for simple widgets
+    /**
+    hover, focus, enable and pressed states are kept in a per widget record,
+    and animations are only allocated, from a pool, when a state actually changes.
+    Derived engines can still insert their own data in the maps, which then take precedence
+    */
     class WidgetStateEngine: public BaseEngine
     {
 
@@ -42,8 +93,7 @@ namespace Inspire
         {}
 
         //* destructor
-        virtual ~WidgetStateEngine( void )
-        {}
+        virtual ~WidgetStateEngine( void );
 
         //* register widget
         virtual bool registerWidget( QWidget*, AnimationModes );
@@ -57,11 +107,12 @@ namespace Inspire
         virtual bool updateState( const QObject*, AnimationMode, bool );
 
         //* true if widget is animated
-        virtual bool isAnimated( const QObject*, AnimationMode );
+        virtual bool isAnimated( const QObject* object, AnimationMode mode )
+        { return animationOpacity( object, mode ) != AnimationData::OpacityInvalid; }
 
         //* animation opacity
         virtual qreal opacity( const QObject* object, AnimationMode mode )
-        { return isAnimated( object, mode ) ? data( object, mode ).data()->opacity(): AnimationData::OpacityInvalid; }
+        { return animationOpacity( object, mode ); }
 
         //* animation mode
         /** precedence on focus */
@@ -77,10 +128,10 @@ namespace Inspire
         /** precedence on focus */
         virtual qreal frameOpacity( const QObject* object )
         {
-            if( isAnimated( object, AnimationEnable ) ) return data( object, AnimationEnable ).data()->opacity();
-            else if( isAnimated( object, AnimationFocus ) ) return data( object, AnimationFocus ).data()->opacity();
-            else if( isAnimated( object, AnimationHover ) ) return data( object, AnimationHover ).data()->opacity();
-            else return AnimationData::OpacityInvalid;
+            qreal opacity;
+            if( ( opacity = animationOpacity( object, AnimationEnable ) ) != AnimationData::OpacityInvalid ) return opacity;
+            else if( ( opacity = animationOpacity( object, AnimationFocus ) ) != AnimationData::OpacityInvalid ) return opacity;
+            else return animationOpacity( object, AnimationHover );
         }
 
         //* animation mode
@@ -98,11 +149,11 @@ namespace Inspire
         /** precedence on mouseOver */
         virtual qreal buttonOpacity( const QObject* object )
         {
-            if( isAnimated( object, AnimationEnable ) ) return data( object, AnimationEnable ).data()->opacity();
-            else if( isAnimated( object, AnimationPressed ) ) return data( object, AnimationPressed ).data()->opacity();
-            else if( isAnimated( object, AnimationHover ) ) return data( object, AnimationHover ).data()->opacity();
-            else if( isAnimated( object, AnimationFocus ) ) return data( object, AnimationFocus ).data()->opacity();
-            else return AnimationData::OpacityInvalid;
+            qreal opacity;
+            if( ( opacity = animationOpacity( object, AnimationEnable ) ) != AnimationData::OpacityInvalid ) return opacity;
+            else if( ( opacity = animationOpacity( object, AnimationPressed ) ) != AnimationData::OpacityInvalid ) return opacity;
+            else if( ( opacity = animationOpacity( object, AnimationHover ) ) != AnimationData::OpacityInvalid ) return opacity;
+            else return animationOpacity( object, AnimationFocus );
         }
 
         //* duration
@@ -116,6 +167,7 @@ namespace Inspire
         }
 
         //* duration
+        /** pooled animations pick it up when next started */
         virtual void setDuration( int value )
         {
             BaseEngine::setDuration( value );
@@ -125,19 +177,14 @@ namespace Inspire
             _pressedData.setDuration( value/2 );
         }
 
+        //* event filter
+        /** follows enable state changes of widgets registered with AnimationEnable */
+        virtual bool eventFilter( QObject*, QEvent* );
+
         public Q_SLOTS:
 
         //* remove widget from map
-        virtual bool unregisterWidget( QObject* object )
-        {
-            if( !object ) return false;
-            bool found = false;
-            if( _hoverData.unregisterWidget( object ) ) found = true;
-            if( _focusData.unregisterWidget( object ) ) found = true;
-            if( _enableData.unregisterWidget( object ) ) found = true;
-            if( _pressedData.unregisterWidget( object ) ) found = true;
-            return found;
-        }
+        virtual bool unregisterWidget( QObject* );
 
         protected:
 
@@ -149,12 +196,54 @@ namespace Inspire
 
         private:
 
-        //* maps
+        friend class WidgetStateAnimation;
+
+        //* per widget state
+        struct Record
+        {
+            //* widget
+            QWidget* target = nullptr;
+
+            //* registered modes
+            AnimationModes registered;
+
+            //* modes for which a first state was received
+            AnimationModes initialized;
+
+            //* current state, per mode
+            AnimationModes state;
+
+            //* animations, per mode, allocated on first state change
+            WidgetStateAnimation* animations[4] = { nullptr, nullptr, nullptr, nullptr };
+        };
+
+        //* index of mode in record animations
+        static int animationIndex( AnimationMode );
+
+        //* running opacity for widget and mode, or OpacityInvalid
+        qreal animationOpacity( const QObject*, AnimationMode );
+
+        //* get animation from pool
+        WidgetStateAnimation* allocateAnimation( QWidget*, AnimationMode );
+
+        //* stop animation and return it to pool
+        void recycleAnimation( WidgetStateAnimation* );
+
+        //* called when an animation reaches its end
+        void animationFinished( WidgetStateAnimation* );
+
+        //* maps, for data inserted by derived engines
         DataMap<WidgetStateData> _hoverData;
         DataMap<WidgetStateData> _focusData;
         DataMap<WidgetStateData> _enableData;
         DataMap<WidgetStateData> _pressedData;
 
+        //* records
+        QHash<const QObject*, Record> _records;
+
+        //* unused animations
+        QVector<WidgetStateAnimation*> _pool;
+
     };
 
 }
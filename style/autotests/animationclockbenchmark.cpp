@@ -0,0 +1,181 @@
+/*************************************************************************
+ * Copyright (C) 2026 Inspire contributors                               *
+ *                                                                       *
+ * This program is free software; you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation; either version 2 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program; if not, write to the                         *
+ * Free Software Foundation, Inc.,                                       *
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA .        *
+ *************************************************************************/
+
+#include "inspireanimation.h"
+
+#include <QGridLayout>
+#include <QTest>
+#include <QVariantAnimation>
+#include <QWidget>
+
+#include <ctime>
+#include <memory>
+#include <vector>
+
+namespace Inspire
+{
+
+//* hundreds of widgets animated at once, by the shared clock and by one QVariantAnimation each
+/**
+ * both run for the same wall time, so the figure that matters is the processor time spent,
+ * which is printed together with the updates issued per frame
+ */
+class AnimationClockBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void clock_data();
+    void clock();
+    void variantAnimations_data();
+    void variantAnimations();
+
+private:
+    //* shown window, with given number of child widgets
+    std::unique_ptr<QWidget> createWindow(int widgets) const;
+
+    //* processor time (ms) spent while running the event loop for given wall time
+    qreal run(int duration) const;
+
+    //* test rows
+    void addRows() const;
+};
+
+//* wall time (ms) the animations run for
+static const int RunDuration = 1000;
+
+//____________________________________________________________
+std::unique_ptr<QWidget> AnimationClockBenchmark::createWindow(int widgets) const
+{
+    std::unique_ptr<QWidget> window(new QWidget());
+    auto layout(new QGridLayout(window.get()));
+    for (int index = 0; index < widgets; ++index) {
+        auto widget(new QWidget(window.get()));
+        widget->setMinimumSize(8, 8);
+        layout->addWidget(widget, index / 25, index % 25);
+    }
+
+    window->show();
+    return window;
+}
+
+//____________________________________________________________
+qreal AnimationClockBenchmark::run(int duration) const
+{
+    const std::clock_t start(std::clock());
+    QTest::qWait(duration);
+    return 1000.0 * (std::clock() - start) / CLOCKS_PER_SEC;
+}
+
+//____________________________________________________________
+void AnimationClockBenchmark::addRows() const
+{
+    QTest::addColumn<int>("widgets");
+
+    QTest::newRow("100 widgets") << 100;
+    QTest::newRow("300 widgets") << 300;
+    QTest::newRow("500 widgets") << 500;
+}
+
+//____________________________________________________________
+void AnimationClockBenchmark::clock_data()
+{
+    addRows();
+}
+
+//____________________________________________________________
+void AnimationClockBenchmark::clock()
+{
+    QFETCH(int, widgets);
+
+    auto window(createWindow(widgets));
+    QVERIFY(QTest::qWaitForWindowExposed(window.get()));
+
+    // same setup as the engines: stepped opacity, which schedules an update of its widget when written
+    AnimationClock &clock(AnimationClock::instance());
+    std::vector<std::unique_ptr<AnimationTimeline>> animations;
+    for (auto widget : window->findChildren<QWidget *>()) {
+        std::unique_ptr<AnimationTimeline> animation(new AnimationTimeline(250));
+        animation->setLoopCount(-1);
+        animation->setStepped(true);
+        animation->setTarget([&clock, widget](qreal) {
+            clock.update(widget);
+        });
+        animation->start();
+        animations.push_back(std::move(animation));
+    }
+
+    const AnimationClock::Statistics before(clock.statistics());
+    const qreal time(run(RunDuration));
+    const AnimationClock::Statistics &after(clock.statistics());
+
+    const quint64 frames(after.frames - before.frames);
+    QVERIFY(frames > 0);
+
+    const quint64 updates(after.updates - before.updates);
+    qDebug("%d widgets: %.1f ms processor time, %llu frames, %.1f steps, %.1f requests and %.1f updates per frame",
+           widgets,
+           time,
+           frames,
+           qreal(after.steps - before.steps) / frames,
+           qreal(after.requests - before.requests) / frames,
+           qreal(updates) / frames);
+
+    // requests are merged into one update of the window per frame
+    QVERIFY(updates <= frames);
+
+    animations.clear();
+    QCOMPARE(clock.runningCount(), 0);
+}
+
+//____________________________________________________________
+void AnimationClockBenchmark::variantAnimations_data()
+{
+    addRows();
+}
+
+//____________________________________________________________
+void AnimationClockBenchmark::variantAnimations()
+{
+    QFETCH(int, widgets);
+
+    auto window(createWindow(widgets));
+    QVERIFY(QTest::qWaitForWindowExposed(window.get()));
+
+    // one animation per widget, as before the shared clock
+    for (auto widget : window->findChildren<QWidget *>()) {
+        auto animation(new QVariantAnimation(window.get()));
+        animation->setDuration(250);
+        animation->setLoopCount(-1);
+        animation->setStartValue(0.0);
+        animation->setEndValue(1.0);
+        connect(animation, &QVariantAnimation::valueChanged, widget, [widget] {
+            widget->update();
+        });
+        animation->start();
+    }
+
+    const qreal time(run(RunDuration));
+    qDebug("%d widgets: %.1f ms processor time", widgets, time);
+}
+}
+
+QTEST_MAIN(Inspire::AnimationClockBenchmark)
+
+#include "animationclockbenchmark.moc"
@@ -0,0 +1,222 @@
+/*************************************************************************
+ * Copyright (C) 2026 Inspire contributors                               *
+ *                                                                       *
+ * This program is free software; you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation; either version 2 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program; if not, write to the                         *
+ * Free Software Foundation, Inc.,                                       *
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA .        *
+ *************************************************************************/
+
+#include "inspiredatamap.h"
+
+#include <QMap>
+#include <QRandomGenerator>
+#include <QTest>
+#include <QVector>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace Inspire
+{
+
+//* minimal animation data, as stored by the engines
+class BenchmarkData : public QObject
+{
+public:
+    void setEnabled(bool)
+    {
+    }
+
+    void setDuration(int)
+    {
+    }
+};
+
+//* data map as it was before the open addressing table, for reference
+/** red-black tree keyed by object, with weak pointers and a single entry last lookup cache */
+class ReferenceDataMap
+{
+public:
+    using Key = const QObject *;
+    using Value = WeakPointer<BenchmarkData>;
+
+    void insert(Key key, BenchmarkData *value)
+    {
+        _map.insert(key, value);
+    }
+
+    Value find(Key key)
+    {
+        if (key == _lastKey)
+            return _lastValue;
+
+        Value out;
+        const auto iter(_map.constFind(key));
+        if (iter != _map.constEnd())
+            out = iter.value();
+        _lastKey = key;
+        _lastValue = out;
+        return out;
+    }
+
+private:
+    QMap<Key, Value> _map;
+    Key _lastKey = nullptr;
+    Value _lastValue;
+};
+
+//* lookup latency of the animation data maps
+class DataMapBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void dataMap_data();
+    void dataMap();
+    void referenceDataMap_data();
+    void referenceDataMap();
+
+private:
+    //* test rows
+    void addRows() const;
+
+    //* keys to look up for given row
+    QVector<const QObject *> lookups(const QString &row) const;
+
+    //* registered keys, in random order
+    QVector<const QObject *> _keys;
+
+    //* keys that are not registered
+    QVector<const QObject *> _missingKeys;
+
+    //* objects used as keys
+    std::vector<std::unique_ptr<QObject>> _objects;
+
+    //* values, shared by both maps, which do not own them
+    std::vector<std::unique_ptr<BenchmarkData>> _values;
+};
+
+//* registered keys
+static const int Entries = 10000;
+
+//____________________________________________________________
+void DataMapBenchmark::initTestCase()
+{
+    for (int index = 0; index < 2 * Entries; ++index) {
+        _objects.emplace_back(new QObject());
+        if (index % 2) {
+            _missingKeys.append(_objects.back().get());
+        } else {
+            _keys.append(_objects.back().get());
+            _values.emplace_back(new BenchmarkData());
+        }
+    }
+
+    // paint order is unrelated to allocation order
+    QRandomGenerator generator(1);
+    std::shuffle(_keys.begin(), _keys.end(), generator);
+    std::shuffle(_missingKeys.begin(), _missingKeys.end(), generator);
+}
+
+//____________________________________________________________
+void DataMapBenchmark::cleanupTestCase()
+{
+    _values.clear();
+    _objects.clear();
+}
+
+//____________________________________________________________
+void DataMapBenchmark::addRows() const
+{
+    QTest::addColumn<QString>("row");
+
+    QTest::newRow("registered keys") << QStringLiteral("registered");
+    QTest::newRow("missing keys") << QStringLiteral("missing");
+
+    // several lookups of the same widget within one paint
+    QTest::newRow("same key") << QStringLiteral("same");
+}
+
+//____________________________________________________________
+QVector<const QObject *> DataMapBenchmark::lookups(const QString &row) const
+{
+    if (row == QLatin1String("missing"))
+        return _missingKeys;
+    else if (row == QLatin1String("same"))
+        return QVector<const QObject *>(Entries, _keys.front());
+    else
+        return _keys;
+}
+
+//____________________________________________________________
+void DataMapBenchmark::dataMap_data()
+{
+    addRows();
+}
+
+//____________________________________________________________
+void DataMapBenchmark::dataMap()
+{
+    QFETCH(QString, row);
+
+    DataMap<BenchmarkData> map;
+    for (int index = 0; index < Entries; ++index)
+        map.insert(_keys[index], _values[index].get());
+
+    const auto keys(lookups(row));
+    int found(0);
+    QBENCHMARK {
+        for (auto key : keys) {
+            if (map.find(key))
+                ++found;
+        }
+    }
+
+    QVERIFY(row == QLatin1String("missing") ? found == 0 : found > 0);
+}
+
+//____________________________________________________________
+void DataMapBenchmark::referenceDataMap_data()
+{
+    addRows();
+}
+
+//____________________________________________________________
+void DataMapBenchmark::referenceDataMap()
+{
+    QFETCH(QString, row);
+
+    ReferenceDataMap map;
+    for (int index = 0; index < Entries; ++index)
+        map.insert(_keys[index], _values[index].get());
+
+    const auto keys(lookups(row));
+    int found(0);
+    QBENCHMARK {
+        for (auto key : keys) {
+            if (map.find(key))
+                ++found;
+        }
+    }
+
+    QVERIFY(row == QLatin1String("missing") ? found == 0 : found > 0);
+}
+}
+
+QTEST_MAIN(Inspire::DataMapBenchmark)
+
+#include "datamapbenchmark.moc"
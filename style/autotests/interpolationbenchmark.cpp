@@ -0,0 +1,141 @@
+/*************************************************************************
+ * Copyright (C) 2026 Inspire contributors                               *
+ *                                                                       *
+ * This program is free software; you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation; either version 2 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program; if not, write to the                         *
+ * Free Software Foundation, Inc.,                                       *
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA .        *
+ *************************************************************************/
+
+#include "inspirehelper.h"
+
+#include <QRandomGenerator>
+#include <QTest>
+#include <QVector>
+
+namespace Inspire
+{
+
+//* animated color interpolation, through QColor mixing and through the packed ARGB32 kernel
+class InterpolationBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void mix_data();
+    void mix();
+    void interpolate_data();
+    void interpolate();
+    void interpolateBatch_data();
+    void interpolateBatch();
+
+private:
+    //* add color counts as benchmark rows
+    void addRows();
+
+    //* random opaque and translucent colors
+    QVector<QColor> _colors1;
+    QVector<QColor> _colors2;
+};
+
+//____________________________________________________________
+void InterpolationBenchmark::initTestCase()
+{
+    // fixed seed, so that runs are comparable
+    QRandomGenerator generator(1);
+    for (int i = 0; i < 1024; ++i) {
+        _colors1.append(QColor::fromRgba(generator.generate()));
+        _colors2.append(QColor::fromRgba(generator.generate()));
+    }
+}
+
+//____________________________________________________________
+void InterpolationBenchmark::addRows()
+{
+    QTest::addColumn<int>("count");
+
+    // roughly the roles of one enable transition palette, and a frame full of animated widgets
+    QTest::newRow("16 colors") << 16;
+    QTest::newRow("1024 colors") << 1024;
+}
+
+//____________________________________________________________
+void InterpolationBenchmark::mix_data()
+{
+    addRows();
+}
+
+//____________________________________________________________
+void InterpolationBenchmark::mix()
+{
+    QFETCH(int, count);
+
+    QVector<QColor> out(count);
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i)
+            out[i] = Helper::mix(_colors1[i], _colors2[i], 0.3);
+    }
+}
+
+//____________________________________________________________
+void InterpolationBenchmark::interpolate_data()
+{
+    addRows();
+}
+
+//____________________________________________________________
+void InterpolationBenchmark::interpolate()
+{
+    QFETCH(int, count);
+
+    QVector<QColor> out(count);
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i)
+            out[i] = Helper::interpolate(_colors1[i], _colors2[i], 0.3);
+    }
+}
+
+//____________________________________________________________
+void InterpolationBenchmark::interpolateBatch_data()
+{
+    addRows();
+}
+
+//____________________________________________________________
+void InterpolationBenchmark::interpolateBatch()
+{
+    QFETCH(int, count);
+
+    // colors are packed once, as the palette transition does
+    QVector<QRgb> rgb1(count);
+    QVector<QRgb> rgb2(count);
+    for (int i = 0; i < count; ++i) {
+        rgb1[i] = qPremultiply(_colors1[i].rgba());
+        rgb2[i] = qPremultiply(_colors2[i].rgba());
+    }
+
+    QVector<QRgb> out(count);
+    QBENCHMARK {
+        Helper::interpolate(rgb1.constData(), rgb2.constData(), out.data(), count, 0.3);
+    }
+
+    // batches give the same result as single colors
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(QColor::fromRgba(qUnpremultiply(out[i])), Helper::interpolate(_colors1[i], _colors2[i], 0.3));
+}
+}
+
+QTEST_MAIN(Inspire::InterpolationBenchmark)
+
+#include "interpolationbenchmark.moc"
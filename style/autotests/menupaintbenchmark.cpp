@@ -0,0 +1,130 @@
+/*************************************************************************
+ * Copyright (C) 2026 Inspire contributors                               *
+ *                                                                       *
+ * This program is free software; you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation; either version 2 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program; if not, write to the                         *
+ * Free Software Foundation, Inc.,                                       *
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA .        *
+ *************************************************************************/
+
+#include "inspirestyle.h"
+
+#include <QApplication>
+#include <QImage>
+#include <QMenu>
+#include <QPainter>
+#include <QPixmap>
+#include <QStyleOptionMenuItem>
+#include <QTest>
+#include <QVector>
+
+namespace Inspire
+{
+
+//* menu that gives access to the style options of its items
+class BenchmarkMenu : public QMenu
+{
+public:
+    using QMenu::initStyleOption;
+};
+
+//* sizes and paints every item of a 500 entry menu, as QMenu does when shown
+/**
+ * items are painted one after the other instead of rendering the menu itself,
+ * because a menu that tall is clamped to the screen and would only paint its visible part
+ */
+class MenuPaintBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void paint_data();
+    void paint();
+
+private:
+    //* style under test, owned by the application
+    Style *_style = nullptr;
+};
+
+//____________________________________________________________
+void MenuPaintBenchmark::initTestCase()
+{
+    _style = new Style();
+    QApplication::setStyle(_style);
+}
+
+//____________________________________________________________
+void MenuPaintBenchmark::paint_data()
+{
+    QTest::addColumn<bool>("icons");
+    QTest::addColumn<bool>("checkable");
+
+    QTest::newRow("text") << false << false;
+    QTest::newRow("icons") << true << false;
+    QTest::newRow("checkable") << false << true;
+}
+
+//____________________________________________________________
+void MenuPaintBenchmark::paint()
+{
+    QFETCH(bool, icons);
+    QFETCH(bool, checkable);
+
+    QPixmap pixmap(16, 16);
+    pixmap.fill(Qt::darkCyan);
+    const QIcon icon(pixmap);
+
+    BenchmarkMenu menu;
+    for (int index = 0; index < 500; ++index) {
+        if (index % 50 == 49) {
+            menu.addSeparator();
+            continue;
+        }
+
+        auto action(menu.addAction(QStringLiteral("Entry %1").arg(index)));
+        action->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_A));
+        if (icons)
+            action->setIcon(icon);
+        if (checkable) {
+            action->setCheckable(true);
+            action->setChecked(index % 2);
+        }
+    }
+    menu.ensurePolished();
+
+    const auto actions(menu.actions());
+    QVector<QStyleOptionMenuItem> options(actions.size());
+    QVector<QSize> contentsSizes(actions.size());
+    for (int index = 0; index < actions.size(); ++index) {
+        menu.initStyleOption(&options[index], actions[index]);
+        contentsSizes[index] = options[index].fontMetrics.size(Qt::TextShowMnemonic, options[index].text);
+    }
+
+    QImage image(300, 40, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+
+    QBENCHMARK {
+        for (int index = 0; index < options.size(); ++index) {
+            auto &option(options[index]);
+            const QSize size(_style->sizeFromContents(QStyle::CT_MenuItem, &option, contentsSizes[index], &menu));
+            option.rect = QRect(QPoint(0, 0), size.boundedTo(image.size()));
+            _style->drawControl(QStyle::CE_MenuItem, &option, &painter, &menu);
+        }
+    }
+}
+}
+
+QTEST_MAIN(Inspire::MenuPaintBenchmark)
+
+#include "menupaintbenchmark.moc"
@@ -0,0 +1,264 @@
+/*************************************************************************
+ * Copyright (C) 2026 Inspire contributors                               *
+ *                                                                       *
+ * This program is free software; you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation; either version 2 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program; if not, write to the                         *
+ * Free Software Foundation, Inc.,                                       *
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA .        *
+ *************************************************************************/
+
+#include "inspirehelper.h"
+
+#include <QImage>
+#include <QTest>
+#include <QtMath>
+
+#include <functional>
+
+namespace Inspire
+{
+
+//* pixel aligned primitives must render exactly as the stroked and antialiased code they replace
+class PixelAlignmentTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void selection_data();
+    void selection();
+    void separator_data();
+    void separator();
+    void sidePanelFrame_data();
+    void sidePanelFrame();
+    void scrollBarGroove_data();
+    void scrollBarGroove();
+
+private:
+    //* add rows for each device pixel ratio, initial antialiasing, rect and variant
+    void addRows(const QList<QPair<QByteArray, int>> &variants = {{QByteArray(), 0}});
+
+    //* render into a transparent image with given device pixel ratio
+    QImage render(qreal devicePixelRatio, bool antialiasing, const std::function<void(QPainter *)> &function) const;
+
+    Helper _helper;
+};
+
+//* translucent, so that pixels covered twice or partially show up
+static const QColor color(40, 120, 200, 160);
+static const QColor outline(200, 60, 20, 200);
+
+//____________________________________________________________
+void PixelAlignmentTest::addRows(const QList<QPair<QByteArray, int>> &variants)
+{
+    QTest::addColumn<qreal>("devicePixelRatio");
+    QTest::addColumn<bool>("antialiasing");
+    QTest::addColumn<QRect>("rect");
+    QTest::addColumn<int>("variant");
+
+    const QList<QRect> rects = {QRect(0, 0, 20, 10), QRect(3, 5, 17, 1), QRect(2, 1, 1, 13), QRect(7, 3, 40, 21)};
+    for (qreal devicePixelRatio : {1.0, 1.5, 2.0}) {
+        for (bool antialiasing : {false, true}) {
+            for (const QRect &rect : rects) {
+                for (const auto &variant : variants) {
+                    const QByteArray name(QByteArray("dpr ") + QByteArray::number(devicePixelRatio) + (antialiasing ? " antialiased " : " aliased ")
+                                          + QByteArray::number(rect.width()) + 'x' + QByteArray::number(rect.height()) + '+'
+                                          + QByteArray::number(rect.x()) + '+' + QByteArray::number(rect.y()) + ' ' + variant.first);
+                    QTest::newRow(name.constData()) << devicePixelRatio << antialiasing << rect << variant.second;
+                }
+            }
+        }
+    }
+}
+
+//____________________________________________________________
+QImage PixelAlignmentTest::render(qreal devicePixelRatio, bool antialiasing, const std::function<void(QPainter *)> &function) const
+{
+    QImage image(qCeil(64 * devicePixelRatio), qCeil(40 * devicePixelRatio), QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(devicePixelRatio);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing, antialiasing);
+    function(&painter);
+    painter.end();
+
+    return image;
+}
+
+//____________________________________________________________
+void PixelAlignmentTest::selection_data()
+{
+    addRows();
+}
+
+//____________________________________________________________
+void PixelAlignmentTest::selection()
+{
+    QFETCH(qreal, devicePixelRatio);
+    QFETCH(bool, antialiasing);
+    QFETCH(QRect, rect);
+
+    const QImage reference(render(devicePixelRatio, antialiasing, [&](QPainter *painter) {
+        painter->setRenderHint(QPainter::Antialiasing);
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(color);
+        painter->drawRect(rect);
+    }));
+
+    const QImage image(render(devicePixelRatio, antialiasing, [&](QPainter *painter) {
+        _helper.renderSelection(painter, rect, color);
+    }));
+
+    QCOMPARE(image, reference);
+}
+
+//____________________________________________________________
+void PixelAlignmentTest::separator_data()
+{
+    addRows({{"horizontal", 0}, {"vertical", 1}});
+}
+
+//____________________________________________________________
+void PixelAlignmentTest::separator()
+{
+    QFETCH(qreal, devicePixelRatio);
+    QFETCH(bool, antialiasing);
+    QFETCH(QRect, rect);
+    QFETCH(int, variant);
+    const bool vertical(variant);
+
+    const QImage reference(render(devicePixelRatio, antialiasing, [&](QPainter *painter) {
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing, false);
+        painter->setBrush(Qt::NoBrush);
+        painter->setPen(color);
+
+        if (vertical) {
+            painter->translate(rect.width() / 2, 0);
+            painter->drawLine(rect.topLeft(), rect.bottomLeft());
+        } else {
+            painter->translate(0, rect.height() / 2);
+            painter->drawLine(rect.topLeft(), rect.topRight());
+        }
+
+        painter->restore();
+    }));
+
+    const QImage image(render(devicePixelRatio, antialiasing, [&](QPainter *painter) {
+        _helper.renderSeparator(painter, rect, color, vertical);
+    }));
+
+    QCOMPARE(image, reference);
+}
+
+//____________________________________________________________
+void PixelAlignmentTest::sidePanelFrame_data()
+{
+    addRows({{"left", SideLeft}, {"top", SideTop}, {"right", SideRight}, {"bottom", SideBottom}});
+}
+
+//____________________________________________________________
+void PixelAlignmentTest::sidePanelFrame()
+{
+    QFETCH(qreal, devicePixelRatio);
+    QFETCH(bool, antialiasing);
+    QFETCH(QRect, rect);
+    QFETCH(int, variant);
+    const Side side(static_cast<Side>(variant));
+
+    const QImage reference(render(devicePixelRatio, antialiasing, [&](QPainter *painter) {
+        QRectF frameRect(rect.adjusted(1, 1, -1, -1));
+        frameRect.adjust(0.5, 0.5, -0.5, -0.5);
+
+        painter->setRenderHint(QPainter::Antialiasing);
+        painter->setPen(outline);
+
+        switch (side) {
+        case SideLeft:
+            frameRect.adjust(0, 1, 0, -1);
+            painter->drawLine(frameRect.topRight(), frameRect.bottomRight());
+            break;
+        case SideTop:
+            frameRect.adjust(1, 0, -1, 0);
+            painter->drawLine(frameRect.topLeft(), frameRect.topRight());
+            break;
+        case SideRight:
+            frameRect.adjust(0, 1, 0, -1);
+            painter->drawLine(frameRect.topLeft(), frameRect.bottomLeft());
+            break;
+        case SideBottom:
+            frameRect.adjust(1, 0, -1, 0);
+            painter->drawLine(frameRect.bottomLeft(), frameRect.bottomRight());
+            break;
+        default:
+            break;
+        }
+    }));
+
+    const QImage image(render(devicePixelRatio, antialiasing, [&](QPainter *painter) {
+        _helper.renderSidePanelFrame(painter, rect, outline, side);
+    }));
+
+    QCOMPARE(image, reference);
+}
+
+//____________________________________________________________
+void PixelAlignmentTest::scrollBarGroove_data()
+{
+    addRows({{"horizontal", 0}, {"vertical", 1}, {"vertical right to left", 2}});
+}
+
+//____________________________________________________________
+void PixelAlignmentTest::scrollBarGroove()
+{
+    QFETCH(qreal, devicePixelRatio);
+    QFETCH(bool, antialiasing);
+    QFETCH(QRect, rect);
+    QFETCH(int, variant);
+
+    // same painting as the groove of Style::drawScrollBarComplexControl
+    const QImage reference(render(devicePixelRatio, antialiasing, [&](QPainter *painter) {
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(color);
+        painter->drawRect(rect);
+
+        painter->setPen(outline);
+        if (variant == 0)
+            painter->drawLine(rect.topLeft(), rect.topRight());
+        else if (variant == 2)
+            painter->drawLine(rect.topRight(), rect.bottomRight());
+        else
+            painter->drawLine(rect.topLeft(), rect.bottomLeft());
+        painter->setPen(Qt::NoPen);
+    }));
+
+    const QImage image(render(devicePixelRatio, antialiasing, [&](QPainter *painter) {
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(color);
+        _helper.fillRect(painter, rect, color);
+
+        if (variant == 0)
+            _helper.drawLine(painter, rect.topLeft(), rect.topRight(), outline);
+        else if (variant == 2)
+            _helper.drawLine(painter, rect.topRight(), rect.bottomRight(), outline);
+        else
+            _helper.drawLine(painter, rect.topLeft(), rect.bottomLeft(), outline);
+    }));
+
+    QCOMPARE(image, reference);
+}
+}
+
+QTEST_MAIN(Inspire::PixelAlignmentTest)
+
+#include "pixelalignmenttest.moc"
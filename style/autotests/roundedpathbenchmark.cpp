@@ -0,0 +1,104 @@
+/*************************************************************************
+ * Copyright (C) 2026 Inspire contributors                               *
+ *                                                                       *
+ * This program is free software; you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation; either version 2 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program; if not, write to the                         *
+ * Free Software Foundation, Inc.,                                       *
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA .        *
+ *************************************************************************/
+
+#include "inspirehelper.h"
+#include "inspirestyle.h"
+
+#include <QApplication>
+#include <QImage>
+#include <QTabWidget>
+#include <QTest>
+
+namespace Inspire
+{
+
+//* rounded paths requested and allocated per tab widget repaint
+class RoundedPathBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void tabWidgetRepaint_data();
+    void tabWidgetRepaint();
+
+private:
+    //* style under test, owned by the application
+    Style *_style = nullptr;
+};
+
+//____________________________________________________________
+void RoundedPathBenchmark::initTestCase()
+{
+    _style = new Style();
+    QApplication::setStyle(_style);
+}
+
+//____________________________________________________________
+void RoundedPathBenchmark::tabWidgetRepaint_data()
+{
+    QTest::addColumn<int>("tabs");
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<qreal>("devicePixelRatio");
+
+    // frames that are not aligned on device pixels are painted directly rather than blitted from the frame cache
+    QTest::newRow("10 tabs, dpr 1") << 10 << QSize(800, 600) << qreal(1);
+    QTest::newRow("10 tabs, dpr 1.5") << 10 << QSize(800, 600) << qreal(1.5);
+    QTest::newRow("10 tabs, dpr 1.5, odd size") << 10 << QSize(801, 601) << qreal(1.5);
+    QTest::newRow("100 tabs, dpr 1.5, odd size") << 100 << QSize(801, 601) << qreal(1.5);
+}
+
+//____________________________________________________________
+void RoundedPathBenchmark::tabWidgetRepaint()
+{
+    QFETCH(int, tabs);
+    QFETCH(QSize, size);
+    QFETCH(qreal, devicePixelRatio);
+
+    QTabWidget tabWidget;
+    for (int i = 0; i < tabs; ++i)
+        tabWidget.addTab(new QWidget(), QStringLiteral("Tab %1").arg(i));
+    tabWidget.resize(size);
+
+    QImage image(size * devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(devicePixelRatio);
+
+    // the first repaint builds paths
+    tabWidget.render(&image);
+
+    const Helper::CacheStatistics before(_style->helper().roundedPathStatistics());
+    int repaints(0);
+    QBENCHMARK {
+        tabWidget.render(&image);
+        ++repaints;
+    }
+    const Helper::CacheStatistics after(_style->helper().roundedPathStatistics());
+
+    // without the cache, every request allocated a path
+    const quint64 requests(after.hits + after.misses - before.hits - before.misses);
+    const quint64 allocations(after.misses - before.misses);
+    qDebug("%.1f rounded paths allocated per repaint without cache, %.1f with cache", qreal(requests) / repaints, qreal(allocations) / repaints);
+
+    QCOMPARE(allocations, quint64(0));
+}
+}
+
+QTEST_MAIN(Inspire::RoundedPathBenchmark)
+
+#include "roundedpathbenchmark.moc"
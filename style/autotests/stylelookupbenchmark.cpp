@@ -0,0 +1,144 @@
+/*************************************************************************
+ * Copyright (C) 2026 Inspire contributors                               *
+ *                                                                       *
+ * This program is free software; you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation; either version 2 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program; if not, write to the                         *
+ * Free Software Foundation, Inc.,                                       *
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA .        *
+ *************************************************************************/
+
+#include "inspirestyle.h"
+
+#include <QTest>
+#include <QVector>
+
+namespace Inspire
+{
+
+//* pixel metric and style hint lookups, as done by layouts
+/** only the public QStyle API is used, so that the same benchmark can run against the switch based lookup */
+class StyleLookupBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void pixelMetric_data();
+    void pixelMetric();
+    void styleHint_data();
+    void styleHint();
+
+private:
+    Style *_style = nullptr;
+};
+
+//____________________________________________________________
+void StyleLookupBenchmark::initTestCase()
+{
+    _style = new Style();
+}
+
+//____________________________________________________________
+void StyleLookupBenchmark::cleanupTestCase()
+{
+    delete _style;
+}
+
+//____________________________________________________________
+void StyleLookupBenchmark::pixelMetric_data()
+{
+    QTest::addColumn<QVector<int>>("metrics");
+
+    QTest::newRow("constant") << QVector<int>{QStyle::PM_LayoutHorizontalSpacing,
+                                              QStyle::PM_LayoutVerticalSpacing,
+                                              QStyle::PM_ButtonDefaultIndicator,
+                                              QStyle::PM_MenuBarItemSpacing,
+                                              QStyle::PM_ToolBarItemSpacing,
+                                              QStyle::PM_TabBarTabOverlap,
+                                              QStyle::PM_ScrollBarExtent,
+                                              QStyle::PM_IndicatorWidth,
+                                              QStyle::PM_HeaderMargin,
+                                              QStyle::PM_SplitterWidth};
+
+    QTest::newRow("context dependent") << QVector<int>{QStyle::PM_DefaultFrameWidth,
+                                                       QStyle::PM_LayoutLeftMargin,
+                                                       QStyle::PM_ButtonMargin,
+                                                       QStyle::PM_MenuHMargin,
+                                                       QStyle::PM_SmallIconSize,
+                                                       QStyle::PM_ToolBarIconSize,
+                                                       QStyle::PM_TitleBarHeight};
+
+    // every metric Qt defines, unhandled ones fall through to the base class
+    QVector<int> all;
+    for (int metric = 0; metric <= QStyle::PM_HeaderDefaultSectionSizeVertical; ++metric)
+        all.append(metric);
+    QTest::newRow("all") << all;
+}
+
+//____________________________________________________________
+void StyleLookupBenchmark::pixelMetric()
+{
+    QFETCH(QVector<int>, metrics);
+
+    int sum(0);
+    QBENCHMARK {
+        for (int metric : metrics)
+            sum += _style->pixelMetric(QStyle::PixelMetric(metric));
+    }
+
+    // keep lookups from being optimized away
+    QVERIFY(sum != 0);
+}
+
+//____________________________________________________________
+void StyleLookupBenchmark::styleHint_data()
+{
+    QTest::addColumn<QVector<int>>("hints");
+
+    QTest::newRow("constant") << QVector<int>{QStyle::SH_ComboBox_ListMouseTracking,
+                                              QStyle::SH_Menu_MouseTracking,
+                                              QStyle::SH_Menu_SubMenuPopupDelay,
+                                              QStyle::SH_Widget_Animate,
+                                              QStyle::SH_TabBar_Alignment,
+                                              QStyle::SH_ScrollBar_MiddleClickAbsolutePosition,
+                                              QStyle::SH_FormLayoutLabelAlignment,
+                                              QStyle::SH_MessageBox_TextInteractionFlags,
+                                              QStyle::SH_TitleBar_NoBorder};
+
+    // every hint Qt defines, unhandled ones fall through to the base class
+    QVector<int> all;
+    for (int hint = 0; hint <= QStyle::SH_SpinBox_StepModifier; ++hint)
+        all.append(hint);
+    QTest::newRow("all") << all;
+}
+
+//____________________________________________________________
+void StyleLookupBenchmark::styleHint()
+{
+    QFETCH(QVector<int>, hints);
+
+    int sum(0);
+    QBENCHMARK {
+        for (int hint : hints)
+            sum += _style->styleHint(QStyle::StyleHint(hint));
+    }
+
+    // keep lookups from being optimized away
+    QVERIFY(sum != 0);
+}
+}
+
+QTEST_MAIN(Inspire::StyleLookupBenchmark)
+
+#include "stylelookupbenchmark.moc"
@@ -109,6 +109,19 @@ namespace Inspire
         const int SplitterProxyWidth { 3 };
         const bool WidgetExplorerEnabled { false };
         const bool DrawWidgetRects { false };
+
+        // Offscreen rendering, can be overridden at runtime with INSPIRE_OFFSCREEN_BACKEND=image|pixmap
+        const bool OffscreenImageBackend { false };
+
+        // Caches
+        const bool FrameCacheEnabled { true };
+        const int FrameCacheSize { 16384 }; // in kilobytes
+        const int RoundedPathCacheSize { 64 }; // in paths
+        const int PaletteColorCacheSize { 96 }; // in color groups
+        const int GradientCacheSize { 256 }; // in brushes
+        const int SizeCacheSize { 4096 }; // in contents sizes
+        const int TabLayoutCacheSize { 1024 }; // in tabs
+        const int TextLayoutCacheSize { 512 }; // in strings
     }
 
     namespace PropertyNames
@@ -119,8 +132,6 @@ namespace Inspire
         const char netWMSkipShadow[] = "_KDE_NET_WM_SKIP_SHADOW";
         const char sidePanelView[] = "_kde_side_panel_view";
         const char toolButtonAlignment[] = "_kde_toolButton_alignment";
-        const char menuTitle[] = "_inspire_toolButton_menutitle";
-        const char alteredBackground[] = "_inspire_altered_background";
     }
 
     //* metrics
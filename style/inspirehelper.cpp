@@ -31,6 +31,12 @@
 #include <QPainter>
 #include <QLibrary>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #if INSPIRE_HAVE_X11 && QT_VERSION < 0x050000
 #include <X11/Xlib-xcb.h>
 #endif
@@ -41,6 +47,29 @@ namespace Inspire
 //* contrast for arrow and treeline rendering
 static const qreal arrowShade = 0.15;
 
+//* largest frame area, in logical pixels, that is rendered through the frame cache
+static const int frameCacheMaxArea = 256 * 256;
+
+//* size of the corner tiles used to compose large frames
+/** must exceed the extent of the rounded corners, including pen width and antialiasing */
+static const int ninePatchMargin = Metrics::Frame_FrameRadius + 3;
+
+//* margin around glyphs rendered through the frame cache
+/** arrows and signs are centered on their rect, but may extend past it */
+static const int glyphMargin = 8;
+
+//* true if value is an integer, up to rounding errors
+static bool isIntegral(qreal value)
+{
+    return qAbs(value - qRound(value)) < 0.01;
+}
+
+//* true if value is a pixel boundary, up to less than the coverage resolution of the rasterizer
+static bool isPixelBoundary(qreal value)
+{
+    return qAbs(value - qRound(value)) < 1.0 / 512;
+}
+
 //____________________________________________________________________
 Helper::Helper()
 {
@@ -53,6 +82,173 @@ void Helper::loadConfig()
     QPalette paletteold( QApplication::palette() );
     paletteold.setColor(QPalette::All,      QPalette::Shadow,          borderGeneric());
     const QPalette palette( paletteold );
+
+    // offscreen backend
+    const QByteArray backend(qgetenv("INSPIRE_OFFSCREEN_BACKEND").toLower());
+    setImageBackend(backend == "image" || (backend != "pixmap" && Config::OffscreenImageBackend));
+
+    // cached frames and color tables depend on the application palette
+    invalidateCaches();
+}
+
+//____________________________________________________________________
+void Helper::setImageBackend(bool value)
+{
+    if (_imageBackend == value)
+        return;
+
+    _imageBackend = value;
+    _frameCache.clear();
+}
+
+//____________________________________________________________________
+void Helper::invalidateCaches()
+{
+    _frameCache.setMaxCost(Config::FrameCacheSize);
+    _frameCache.clear();
+
+    _roundedPathCache.setMaxCost(Config::RoundedPathCacheSize);
+    _roundedPathCache.clear();
+
+    _paletteColorCache.setMaxCost(Config::PaletteColorCacheSize);
+    _paletteColorCache.clear();
+
+    _gradientCache.setMaxCost(Config::GradientCacheSize);
+    _gradientCache.clear();
+}
+
+//____________________________________________________________________
+void Helper::interpolate(const QRgb *c1, const QRgb *c2, QRgb *out, int count, qreal bias)
+{
+    // fixed point weight, so that each channel is ( c1*(256-weight) + c2*weight ) >> 8, which fits in 16 bits
+    const uint weight(std::isnan(bias) ? 0 : uint(qRound(qBound(qreal(0.0), bias, qreal(1.0)) * 256)));
+    int i = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero(_mm_setzero_si128());
+    const __m128i weight1(_mm_set1_epi16(short(256 - weight)));
+    const __m128i weight2(_mm_set1_epi16(short(weight)));
+    auto blend = [&](__m128i a, __m128i b) {
+        return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(a, weight1), _mm_mullo_epi16(b, weight2)), 8);
+    };
+
+    // four colors at a time
+    for (; i + 4 <= count; i += 4) {
+        const __m128i a(_mm_loadu_si128(reinterpret_cast<const __m128i *>(c1 + i)));
+        const __m128i b(_mm_loadu_si128(reinterpret_cast<const __m128i *>(c2 + i)));
+        const __m128i low(blend(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)));
+        const __m128i high(blend(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(low, high));
+    }
+
+    // remaining colors
+    for (; i < count; ++i) {
+        const __m128i a(_mm_unpacklo_epi8(_mm_cvtsi32_si128(int(c1[i])), zero));
+        const __m128i b(_mm_unpacklo_epi8(_mm_cvtsi32_si128(int(c2[i])), zero));
+        out[i] = QRgb(_mm_cvtsi128_si32(_mm_packus_epi16(blend(a, b), zero)));
+    }
+#elif defined(__ARM_NEON)
+    const uint16x8_t weight1(vdupq_n_u16(uint16_t(256 - weight)));
+    const uint16x8_t weight2(vdupq_n_u16(uint16_t(weight)));
+    auto blend = [&](uint8x8_t a, uint8x8_t b) {
+        return vshrn_n_u16(vmlaq_u16(vmulq_u16(vmovl_u8(a), weight1), vmovl_u8(b), weight2), 8);
+    };
+
+    // two colors at a time
+    for (; i + 2 <= count; i += 2) {
+        const uint8x8_t a(vld1_u8(reinterpret_cast<const uint8_t *>(c1 + i)));
+        const uint8x8_t b(vld1_u8(reinterpret_cast<const uint8_t *>(c2 + i)));
+        vst1_u8(reinterpret_cast<uint8_t *>(out + i), blend(a, b));
+    }
+
+    // remaining color
+    for (; i < count; ++i) {
+        const uint8x8_t a(vreinterpret_u8_u32(vdup_n_u32(c1[i])));
+        const uint8x8_t b(vreinterpret_u8_u32(vdup_n_u32(c2[i])));
+        out[i] = vget_lane_u32(vreinterpret_u32_u8(blend(a, b)), 0);
+    }
+#else
+    auto blend = [weight](QRgb a, QRgb b, int shift) {
+        return (((a >> shift) & 0xff) * (256 - weight) + ((b >> shift) & 0xff) * weight) >> 8 << shift;
+    };
+
+    for (; i < count; ++i)
+        out[i] = blend(c1[i], c2[i], 0) | blend(c1[i], c2[i], 8) | blend(c1[i], c2[i], 16) | blend(c1[i], c2[i], 24);
+#endif
+}
+
+//____________________________________________________________________
+QColor Helper::interpolate(const QColor &c1, const QColor &c2, qreal bias)
+{
+    if (bias <= 0.0 || std::isnan(bias))
+        return c1;
+    if (bias >= 1.0)
+        return c2;
+
+    const QRgb rgb1(qPremultiply(c1.rgba()));
+    const QRgb rgb2(qPremultiply(c2.rgba()));
+    QRgb rgb;
+    interpolate(&rgb1, &rgb2, &rgb, 1, bias);
+    return QColor::fromRgba(qUnpremultiply(rgb));
+}
+
+//____________________________________________________________________
+Helper::PaletteColors Helper::paletteColors(const QPalette &palette, QPalette::ColorGroup group) const
+{
+    if (group < 0 || group >= QPalette::NColorGroups)
+        group = palette.currentColorGroup();
+
+    const PaletteColorKey key(palette, group);
+    if (const PaletteColors *colors = _paletteColorCache.object(key))
+        return *colors;
+
+    // insertion may delete the inserted entry, return a copy built beforehand
+    const PaletteColors colors(createPaletteColors(palette, group));
+    _paletteColorCache.insert(key, new PaletteColors(colors));
+    return colors;
+}
+
+//____________________________________________________________________
+QBrush Helper::gradientBrush(const QColor &bottom, const QColor &top) const
+{
+    const quint64 key((quint64(bottom.rgba()) << 32) | top.rgba());
+    if (const QBrush *brush = _gradientCache.object(key))
+        return *brush;
+
+    QLinearGradient gradient(0, 1, 0, 0);
+    gradient.setCoordinateMode(QGradient::ObjectBoundingMode);
+    gradient.setColorAt(0, bottom);
+    gradient.setColorAt(1, top);
+
+    const QBrush brush(gradient);
+    _gradientCache.insert(key, new QBrush(brush));
+    return brush;
+}
+
+//____________________________________________________________________
+Helper::PaletteColors Helper::createPaletteColors(const QPalette &palette, QPalette::ColorGroup group) const
+{
+    PaletteColors colors;
+    colors.frameOutline = darken(palette.color(group, QPalette::Window), 0.19);
+    colors.indicatorOutlineChecked = darken(palette.color(group, QPalette::Highlight), 0.005);
+    colors.indicatorBackgroundSunken = darken(palette.color(group, QPalette::Base), 0.14);
+    colors.indicatorBackgroundHover = lighten(palette.color(group, QPalette::Base), 0.09);
+
+    // Defined in drawing.css - insensitive button
+    // $insensitive_bg_color: mix($bg_color, $base_color, 60%);
+    colors.indicatorBackgroundDisabled = mix(palette.color(QPalette::Active, QPalette::Window), palette.color(QPalette::Active, QPalette::Base), 0.6);
+
+    // Defined in drawing.css - insensitive-active button
+    // if($variant == 'light', darken(mix($c, $base_color, 85%), 8%), darken(mix($c, $base_color, 85%), 6%));
+    // FIXME: doesn't seem to be correct color
+    colors.buttonBackgroundDisabledSunken = mix(palette.color(QPalette::Active, QPalette::Window), palette.color(QPalette::Active, QPalette::Highlight), 0.15);
+
+    colors.arrowText = mix(palette.color(group, QPalette::Text), palette.color(group, QPalette::Base), arrowShade);
+    colors.arrowWindowText = mix(palette.color(group, QPalette::WindowText), palette.color(group, QPalette::Window), arrowShade);
+    colors.arrowButtonText = mix(palette.color(group, QPalette::ButtonText), palette.color(group, QPalette::Button), arrowShade);
+    colors.sliderOutline = mix(palette.color(group, QPalette::Window), palette.color(group, QPalette::Shadow), 0.5);
+    colors.checkBoxIndicatorInactive = transparentize(palette.color(group, QPalette::Text), 0.2);
+    return colors;
 }
 
 //____________________________________________________________________
@@ -77,7 +273,7 @@ QColor Helper::indicatorOutlineColor(const QPalette &palette, bool mouseOver, bo
     } else if (state == CheckBoxState::CheckOff) {
         return menuOutlineColor(palette);
     } else {
-        return darken(palette.color(QPalette::Highlight), 0.005);
+        return paletteColors(palette).indicatorOutlineChecked;
     }
 }
 
@@ -87,7 +283,7 @@ QColor Helper::frameOutlineColor(const QPalette &palette, bool mouseOver, bool h
     if (hasFocus) {
         return focusColor(palette);
     } else {
-        return darken(palette.color(QPalette::Window), 0.19);
+        return paletteColors(palette).frameOutline;
     }
 }
 
@@ -97,7 +293,7 @@ QColor Helper::inputOutlineColor(const QPalette &palette, bool mouseOver, bool h
 
     // focus takes precedence over hover
     if (mode == AnimationFocus) {
-        outline = mix(outline, focusColor(palette), opacity);
+        outline = interpolate(outline, focusColor(palette), opacity);
     } else if (hasFocus) {
         outline = focusColor(palette);
     }
@@ -112,7 +308,7 @@ QColor Helper::sidePanelOutlineColor(const QPalette &palette, bool hasFocus, qre
     QColor focus(palette.color(QPalette::Active, QPalette::Highlight));
 
     if (mode == AnimationFocus) {
-        outline = mix(outline, focus, opacity);
+        outline = interpolate(outline, focus, opacity);
     } else if (hasFocus) {
         outline = focus;
     }
@@ -144,11 +340,11 @@ QColor Helper::arrowColor(const QPalette &palette, QPalette::ColorGroup group, Q
 {
     switch (role) {
     case QPalette::Text:
-        return mix(palette.color(group, QPalette::Text), palette.color(group, QPalette::Base), arrowShade);
+        return paletteColors(palette, group).arrowText;
     case QPalette::WindowText:
-        return mix(palette.color(group, QPalette::WindowText), palette.color(group, QPalette::Window), arrowShade);
+        return paletteColors(palette, group).arrowWindowText;
     case QPalette::ButtonText:
-        return mix(palette.color(group, QPalette::ButtonText), palette.color(group, QPalette::Button), arrowShade);
+        return paletteColors(palette, group).arrowButtonText;
     default:
         return palette.color(group, role);
     }
@@ -178,12 +374,8 @@ QColor Helper::buttonBackgroundColor(const QPalette &palette, bool mouseOver, bo
     QColor buttonBackground(palette.color(QPalette::Button));
     QColor background(palette.color(QPalette::Window));
 
-    if (isDisabled && (mode == AnimationPressed || sunken)) {
-        // Defined in drawing.css - insensitive-active button
-        // if($variant == 'light', darken(mix($c, $base_color, 85%), 8%), darken(mix($c, $base_color, 85%), 6%));
-        // FIXME: doesn't seem to be correct color
-        return mix(palette.color(QPalette::Active, QPalette::Window), palette.color(QPalette::Active, QPalette::Highlight), 0.15);
-    }
+    if (isDisabled && (mode == AnimationPressed || sunken))
+        return paletteColors(palette).buttonBackgroundDisabledSunken;
 
     return buttonBackground;
 }
@@ -200,18 +392,15 @@ QColor Helper::indicatorBackgroundColor(const QPalette &palette, bool mouseOver,
         return palette.color(QPalette::Base);
     }
     if (state == CheckOff) {
-        if (isDisabled) {
-            // Defined in drawing.css - insensitive button
-            // $insensitive_bg_color: mix($bg_color, $base_color, 60%);
-            return mix(palette.color(QPalette::Active, QPalette::Window), palette.color(QPalette::Active, QPalette::Base), 0.6);
-        }
+        if (isDisabled)
+            return paletteColors(palette).indicatorBackgroundDisabled;
 
         if (mode == AnimationPressed) {
-            return darken(background, 0.14);
+            return paletteColors(palette).indicatorBackgroundSunken;
         } else if (sunken) {
-            return darken(background, 0.14);
+            return paletteColors(palette).indicatorBackgroundSunken;
         } else if (mode == AnimationHover) {
-            return lighten(background, 0.09);
+            return paletteColors(palette).indicatorBackgroundHover;
         } else if (mouseOver) {
             return background;
         }
@@ -233,21 +422,21 @@ QColor Helper::toolButtonColor(const QPalette &palette, bool mouseOver, bool has
 //____________________________________________________________________
 QColor Helper::sliderOutlineColor(const QPalette &palette, bool mouseOver, bool hasFocus, qreal opacity, AnimationMode mode) const
 {
-    QColor outline(mix(palette.color(QPalette::Window), palette.color(QPalette::Shadow), 0.5));
+    QColor outline(paletteColors(palette).sliderOutline);
 
     // hover takes precedence over focus
     if (mode == AnimationHover) {
         QColor hover(hoverColor(palette));
         QColor focus(focusColor(palette));
         if (hasFocus)
-            outline = mix(focus, hover, opacity);
+            outline = interpolate(focus, hover, opacity);
         else
-            outline = mix(outline, hover, opacity);
+            outline = interpolate(outline, hover, opacity);
     } else if (mouseOver) {
         outline = hoverColor(palette);
     } else if (mode == AnimationFocus) {
         QColor focus(focusColor(palette));
-        outline = mix(outline, focus, opacity);
+        outline = interpolate(outline, focus, opacity);
     } else if (hasFocus) {
         outline = focusColor(palette);
     }
@@ -290,7 +479,7 @@ QColor Helper::checkBoxIndicatorColor(const QPalette &palette, bool mouseOver, b
         if (active) {
             return palette.color(QPalette::HighlightedText);
         } else {
-            return transparentize(palette.color(QPalette::Text), 0.2);
+            return paletteColors(palette).checkBoxIndicatorInactive;
         }
     }
 }
@@ -326,11 +515,22 @@ QPalette Helper::disabledPalette(const QPalette &source, qreal ratio) const
 {
     QPalette copy(source);
 
-    const QList<QPalette::ColorRole> roles = { QPalette::Background, QPalette::Highlight, QPalette::WindowText, QPalette::ButtonText, QPalette::Text, QPalette::Button };
-    foreach (const QPalette::ColorRole &role, roles) {
-        copy.setColor(role, mix(source.color(QPalette::Active, role), source.color(QPalette::Disabled, role), 1.0 - ratio));
+    const QPalette::ColorRole roles[] = { QPalette::Background, QPalette::Highlight, QPalette::WindowText, QPalette::ButtonText, QPalette::Text, QPalette::Button };
+    const int count(sizeof(roles) / sizeof(roles[0]));
+
+    // interpolate all roles at once
+    QRgb active[count];
+    QRgb disabled[count];
+    QRgb colors[count];
+    for (int i = 0; i < count; ++i) {
+        active[i] = qPremultiply(source.color(QPalette::Active, roles[i]).rgba());
+        disabled[i] = qPremultiply(source.color(QPalette::Disabled, roles[i]).rgba());
     }
 
+    interpolate(active, disabled, colors, count, 1.0 - ratio);
+    for (int i = 0; i < count; ++i)
+        copy.setColor(roles[i], QColor::fromRgba(qUnpremultiply(colors[i])));
+
     return copy;
 }
 
@@ -422,6 +622,17 @@ void Helper::renderFrame(QPainter *painter, const QRect &rect, const QColor &col
 {
     painter->setRenderHint(QPainter::Antialiasing);
 
+    FrameCacheKey key(FrameGeneric, rect.size(), hasFocus, color, outline);
+    auto render = [=](QPainter *painter, const QRect &rect) { paintFrame(painter, rect, color, outline, hasFocus); };
+    if (!renderCachedFrame(painter, rect, key, render, Qt::Horizontal | Qt::Vertical))
+        paintFrame(painter, rect, color, outline, hasFocus);
+}
+
+//______________________________________________________________________________
+void Helper::paintFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline, bool hasFocus) const
+{
+    painter->setRenderHint(QPainter::Antialiasing);
+
     QRectF frameRect(rect.adjusted(1, 1, -1, -1));
     qreal radius(frameRadius());
 
@@ -525,19 +736,19 @@ void Helper::renderSidePanelFrame(QPainter *painter, const QRect &rect, const QC
     switch (side) {
     case SideLeft:
         frameRect.adjust(0, 1, 0, -1);
-        painter->drawLine(frameRect.topRight(), frameRect.bottomRight());
+        drawLine(painter, frameRect.topRight(), frameRect.bottomRight(), outline);
         break;
     case SideTop:
         frameRect.adjust(1, 0, -1, 0);
-        painter->drawLine(frameRect.topLeft(), frameRect.topRight());
+        drawLine(painter, frameRect.topLeft(), frameRect.topRight(), outline);
         break;
     case SideRight:
         frameRect.adjust(0, 1, 0, -1);
-        painter->drawLine(frameRect.topLeft(), frameRect.bottomLeft());
+        drawLine(painter, frameRect.topLeft(), frameRect.bottomLeft(), outline);
         break;
     case SideBottom:
         frameRect.adjust(1, 0, -1, 0);
-        painter->drawLine(frameRect.bottomLeft(), frameRect.bottomRight());
+        drawLine(painter, frameRect.bottomLeft(), frameRect.bottomRight(), outline);
         break;
     case AllSides: {
         qreal radius(frameRadius(-1.0));
@@ -551,6 +762,18 @@ void Helper::renderSidePanelFrame(QPainter *painter, const QRect &rect, const QC
 
 //______________________________________________________________________________
 void Helper::renderMenuFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline, const QPalette &palette) const
+{
+    painter->setRenderHint(QPainter::Antialiasing, false);
+
+    // outline color itself is not used, only its validity
+    FrameCacheKey key(FrameMenu, rect.size(), outline.isValid(), color, outline.isValid() ? palette.color(QPalette::Base) : QColor());
+    auto render = [=](QPainter *painter, const QRect &rect) { paintMenuFrame(painter, rect, color, outline, palette); };
+    if (!renderCachedFrame(painter, rect, key, render, Qt::Horizontal | Qt::Vertical))
+        paintMenuFrame(painter, rect, color, outline, palette);
+}
+
+//______________________________________________________________________________
+void Helper::paintMenuFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline, const QPalette &palette) const
 {
     // set brush
     if (color.isValid()) 
@@ -576,17 +799,26 @@ void Helper::renderMenuFrame(QPainter *painter, const QRect &rect, const QColor
 //______________________________________________________________________________
 void Helper::renderTooltipFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline, bool roundCorners) const
 {
+    painter->setRenderHint(QPainter::Antialiasing, false);
+
+    // the background gradient is vertical, so filled tooltips can only be stretched horizontally
+    FrameCacheKey key(FrameTooltip, rect.size(), 0, color, outline);
+    auto render = [=](QPainter *painter, const QRect &rect) { paintTooltipFrame(painter, rect, color, outline); };
+    Qt::Orientations stretch(color.isValid() ? Qt::Horizontal : Qt::Horizontal | Qt::Vertical);
+    if (!renderCachedFrame(painter, rect, key, render, stretch))
+        paintTooltipFrame(painter, rect, color, outline);
+}
 
+//______________________________________________________________________________
+void Helper::paintTooltipFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline) const
+{
     painter->setRenderHint(QPainter::Antialiasing, false);
     QRectF frameRect(rect);
     
     // set brush
-    if (color.isValid()) {
-        QLinearGradient gradient(frameRect.bottomLeft(), frameRect.topLeft());
-        gradient.setColorAt(0, darken(color, 0.05));
-        gradient.setColorAt(1, color);
-        painter->setBrush(gradient);
-    } else
+    if (color.isValid())
+        painter->setBrush(gradientBrush(darken(color, 0.05), color));
+    else
         painter->setBrush(Qt::NoBrush);
     
     if (outline.isValid()) {
@@ -612,6 +844,22 @@ void Helper::renderButtonFrame(QPainter *painter, const QRect &rect, const QColo
     // setup painter
     painter->setRenderHint(QPainter::Antialiasing, true);
 
+    // sunken buttons use the palette highlight, and a different outline when disabled
+    bool isDisabled(sunken && palette.currentColorGroup() == QPalette::Disabled);
+    FrameCacheKey key(FrameButton, rect.size(), sunken | (mouseOver << 1) | (active << 2) | (isDisabled << 3),
+                      color, outline, sunken ? palette.color(QPalette::Highlight) : QColor());
+    auto render = [=](QPainter *painter, const QRect &rect) { paintButtonFrame(painter, rect, color, outline, sunken, mouseOver, active, palette); };
+    if (!renderCachedFrame(painter, rect, key, render))
+        paintButtonFrame(painter, rect, color, outline, sunken, mouseOver, active, palette);
+}
+
+//______________________________________________________________________________
+void Helper::paintButtonFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline,
+                              bool sunken, bool mouseOver, bool active, const QPalette &palette) const
+{
+    // setup painter
+    painter->setRenderHint(QPainter::Antialiasing, true);
+
     // copy rect
     QRectF frameRect(rect);
     frameRect.adjust(1, 1, -1, -1);
@@ -627,22 +875,17 @@ void Helper::renderButtonFrame(QPainter *painter, const QRect &rect, const QColo
 
     // content
     if (color.isValid()) {
-        QLinearGradient gradient(frameRect.bottomLeft(), frameRect.topLeft());
         if (sunken) {
             // Pressed button in normal and dark mode is not a gradient, just an image consting from same $color
             QColor background(indicatorBackgroundColor(palette, mouseOver, false, sunken, AnimationData::OpacityInvalid, AnimationNone, CheckOn));
-            gradient.setColorAt(0, darken(background, 0.014));
-            gradient.setColorAt(1, background);
+            painter->setBrush(gradientBrush(darken(background, 0.014), background));
         } else if (mouseOver) {
             // Hovered button in normal mode is a gradient from $color to lighten(bg_color, 0.01)
-            gradient.setColorAt(0, lighten(color, 0.01));
-            gradient.setColorAt(1, lighten(color, 0.04));
+            painter->setBrush(gradientBrush(lighten(color, 0.01), lighten(color, 0.04)));
         } else {
             // Normal button in normal mode is a gradient from $color to bg_color
-            gradient.setColorAt(0, darken(color, 0.03));
-            gradient.setColorAt(1, color);
+            painter->setBrush(gradientBrush(darken(color, 0.03), color));
         }
-        painter->setBrush(gradient);
     } else if (!active) {
         painter->setBrush(color);
     } else {
@@ -671,6 +914,23 @@ void Helper::renderCheckBoxFrame(QPainter *painter, const QRect &rect, const QCo
     // setup painter
     painter->setRenderHint(QPainter::Antialiasing, true);
 
+    // only the palette colors actually used by the primitive go into the key
+    QColor text(inMenu ? palette.color(QPalette::Text) : QColor());
+    QColor base(inMenu ? palette.color(QPalette::Base) : QColor());
+    QColor highlight(!inMenu && state != CheckOff ? palette.color(QPalette::Highlight) : QColor());
+    FrameCacheKey key(FrameCheckBox, rect.size(), state | (inMenu << 2), color, outline, inMenu ? text : highlight, base);
+    auto render = [=](QPainter *painter, const QRect &rect) { paintCheckBoxFrame(painter, rect, color, outline, palette, state, inMenu); };
+    if (!renderCachedFrame(painter, rect, key, render))
+        paintCheckBoxFrame(painter, rect, color, outline, palette, state, inMenu);
+}
+
+//______________________________________________________________________________
+void Helper::paintCheckBoxFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline, const QPalette &palette,
+                                CheckBoxState state, bool inMenu) const
+{
+    // setup painter
+    painter->setRenderHint(QPainter::Antialiasing, true);
+
     // copy rect
     QRectF frameRect(rect);
     frameRect.adjust(1, 1, -1, -1);
@@ -706,10 +966,7 @@ void Helper::renderCheckBoxFrame(QPainter *painter, const QRect &rect, const QCo
         }
     } else {
         if (color.isValid()) {
-            QLinearGradient gradient(frameRect.bottomLeft(), frameRect.topLeft());
-            gradient.setColorAt(0, darken(color, 0.014));
-            gradient.setColorAt(1, color);
-            painter->setBrush(gradient);
+            painter->setBrush(gradientBrush(darken(color, 0.014), color));
         } else {
             painter->setBrush(Qt::NoBrush);
         }
@@ -726,6 +983,18 @@ void Helper::renderFlatButtonFrame(QPainter *painter, const QRect &rect, const Q
     // setup painter
     painter->setRenderHint(QPainter::Antialiasing, true);
 
+    FrameCacheKey key(FrameFlatButton, rect.size(), sunken | (active << 1), color, outline);
+    auto render = [=](QPainter *painter, const QRect &rect) { paintFlatButtonFrame(painter, rect, color, outline, sunken, active); };
+    if (!renderCachedFrame(painter, rect, key, render))
+        paintFlatButtonFrame(painter, rect, color, outline, sunken, active);
+}
+
+//______________________________________________________________________________
+void Helper::paintFlatButtonFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline, bool sunken, bool active) const
+{
+    // setup painter
+    painter->setRenderHint(QPainter::Antialiasing, true);
+
     // copy rect
     QRectF frameRect(rect);
     frameRect.adjust(1, 1, -1, -1);
@@ -741,19 +1010,14 @@ void Helper::renderFlatButtonFrame(QPainter *painter, const QRect &rect, const Q
 
     // content
     if (color.isValid()) {
-        QLinearGradient gradient(frameRect.topLeft(), frameRect.bottomLeft());
         //gradient.setColorAt( 0, color.darker( sunken ? 110 : (hasFocus|mouseOver) ? 85 : 100 ) );
         //gradient.setColorAt( 1, color.darker( sunken ? 130 : (hasFocus|mouseOver) ? 95 : 110 ) );
 
-        if (!active) {
-            gradient.setColorAt(0, color);
-        } else if (sunken) {
-            gradient.setColorAt(0, color);
-        } else {
-            gradient.setColorAt(0, mix(color, Qt::white, 0.07));
-            gradient.setColorAt(1, mix(color, Qt::black, 0.1));
-        }
-        painter->setBrush(gradient);
+        // a gradient with a single stop is a plain color
+        if (!active || sunken)
+            painter->setBrush(color);
+        else
+            painter->setBrush(gradientBrush(mix(color, Qt::black, 0.1), mix(color, Qt::white, 0.07)));
     } else
         painter->setBrush(Qt::NoBrush);
 
@@ -774,6 +1038,147 @@ void Helper::renderFlatButtonFrame(QPainter *painter, const QRect &rect, const Q
     //painter->drawRoundedRect( frameRect, radius, radius );
 }
 
+//______________________________________________________________________________
+bool Helper::canCacheFrame(QPainter *painter, const QRect &rect, qreal *devicePixelRatio) const
+{
+    if (!Config::FrameCacheEnabled || !rect.isValid())
+        return false;
+
+    // blitting only matches direct rendering for plain source-over painting
+    if (painter->compositionMode() != QPainter::CompositionMode_SourceOver || painter->opacity() < 1.0)
+        return false;
+
+    // and for unrotated painters, with the frame aligned on device pixels
+    const QTransform &transform(painter->deviceTransform());
+    if (transform.type() > QTransform::TxScale || transform.m11() != transform.m22() || transform.m11() <= 0)
+        return false;
+
+    const qreal dpr(transform.m11());
+    const QPointF origin(transform.map(QPointF(rect.topLeft())));
+    if (!(isIntegral(origin.x()) && isIntegral(origin.y()) && isIntegral(rect.width() * dpr) && isIntegral(rect.height() * dpr)))
+        return false;
+
+    *devicePixelRatio = dpr;
+    return true;
+}
+
+//______________________________________________________________________________
+Helper::CachedFrame Helper::cachedFrame(const FrameCacheKey &key, const std::function<void(QPainter *, const QRect &)> &render) const
+{
+    CacheStatistics &statistics(_frameCacheStatistics[key.primitive]);
+    if (const CachedFrame *frame = _frameCache.object(key)) {
+        ++statistics.hits;
+        return *frame;
+    }
+
+    ++statistics.misses;
+
+    // render frame once, in local coordinates
+    const qreal dpr(key.devicePixelRatio);
+    const QSize size(qRound(key.size.width() * dpr), qRound(key.size.height() * dpr));
+    CachedFrame frame;
+    QPaintDevice *device;
+    if (_imageBackend) {
+        frame.image = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        frame.image.setDevicePixelRatio(dpr);
+        frame.image.fill(Qt::transparent);
+        device = &frame.image;
+    } else {
+        frame.pixmap = QPixmap(size);
+        frame.pixmap.setDevicePixelRatio(dpr);
+        frame.pixmap.fill(Qt::transparent);
+        device = &frame.pixmap;
+    }
+
+    {
+        QPainter cachePainter(device);
+        render(&cachePainter, QRect(QPoint(0, 0), key.size));
+    }
+
+    // pixmaps and images are implicitly shared, the returned copy stays valid even if the cache drops it
+    _frameCache.insert(key, new CachedFrame(frame), frame.cost());
+    return frame;
+}
+
+//______________________________________________________________________________
+bool Helper::renderCachedFrame(QPainter *painter, const QRect &rect, FrameCacheKey key, const std::function<void(QPainter *, const QRect &)> &render,
+                               Qt::Orientations stretch) const
+{
+    qreal dpr;
+    if (!canCacheFrame(painter, rect, &dpr))
+        return false;
+
+    key.devicePixelRatio = dpr;
+
+    // small frames are cached as a whole
+    if (rect.width() * rect.height() <= frameCacheMaxArea) {
+        cachedFrame(key, render).draw(painter, rect.topLeft());
+        return true;
+    }
+
+    // larger frames are composed from a tile of minimal size along the stretchable directions
+    // tile segments must map to whole device pixels
+    if (!stretch || !isIntegral(dpr))
+        return false;
+
+    const bool stretchHorizontal((stretch & Qt::Horizontal) && rect.width() > 2 * ninePatchMargin + 1);
+    const bool stretchVertical((stretch & Qt::Vertical) && rect.height() > 2 * ninePatchMargin + 1);
+    key.size = QSize(stretchHorizontal ? 2 * ninePatchMargin + 1 : rect.width(), stretchVertical ? 2 * ninePatchMargin + 1 : rect.height());
+    if (key.size.width() * key.size.height() > frameCacheMaxArea)
+        return false;
+
+    const CachedFrame tile(cachedFrame(key, render));
+
+    // split each direction in corner, stretchable edge and corner segments
+    // the stretchable segment is one logical pixel wide in the tile
+    struct Segment {
+        qreal source;
+        qreal sourceLength;
+        int target;
+        int targetLength;
+    };
+
+    auto segments = [dpr](int target, int length, bool stretchable) -> QVector<Segment> {
+        QVector<Segment> out;
+        if (!stretchable) {
+            out.append({ 0, length * dpr, target, length });
+        } else {
+            out.append({ 0, ninePatchMargin * dpr, target, ninePatchMargin });
+            out.append({ ninePatchMargin * dpr, dpr, target + ninePatchMargin, length - 2 * ninePatchMargin });
+            out.append({ (ninePatchMargin + 1) * dpr, ninePatchMargin * dpr, target + length - ninePatchMargin, ninePatchMargin });
+        }
+        return out;
+    };
+
+    const QVector<Segment> columns(segments(rect.left(), rect.width(), stretchHorizontal));
+    const QVector<Segment> rows(segments(rect.top(), rect.height(), stretchVertical));
+
+    // stretched edges are uniform, so nearest neighbour scaling is exact
+    const bool smooth(painter->testRenderHint(QPainter::SmoothPixmapTransform));
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, false);
+    for (const Segment &row : rows) {
+        for (const Segment &column : columns) {
+            tile.draw(painter, QRectF(column.target, row.target, column.targetLength, row.targetLength),
+                      QRectF(column.source, row.source, column.sourceLength, row.sourceLength));
+        }
+    }
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, smooth);
+
+    return true;
+}
+
+//______________________________________________________________________________
+int Helper::indicatorAnimationStep(qreal animation) const
+{
+    // animation values are digitized by AnimationData, so that only a fixed number of steps is ever rendered
+    const int steps(AnimationData::steps());
+    if (steps <= 0 || animation < 0 || animation > 1.0)
+        return -1;
+
+    const qreal step(animation * steps);
+    return isIntegral(step) ? qRound(step) : -1;
+}
+
 //______________________________________________________________________________
 void Helper::renderToolButtonFrame(QPainter *painter, const QRect &rect, const QColor &color, bool sunken) const
 {
@@ -853,6 +1258,17 @@ void Helper::renderTabWidgetFrame(QPainter *painter, const QRect &rect, const QC
 {
     painter->setRenderHint(QPainter::Antialiasing);
 
+    FrameCacheKey key(FrameTabWidget, rect.size(), uint(corners), color, outline);
+    auto render = [=](QPainter *painter, const QRect &rect) { paintTabWidgetFrame(painter, rect, color, outline, corners); };
+    if (!renderCachedFrame(painter, rect, key, render, Qt::Horizontal | Qt::Vertical))
+        paintTabWidgetFrame(painter, rect, color, outline, corners);
+}
+
+//______________________________________________________________________________
+void Helper::paintTabWidgetFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline, Corners corners) const
+{
+    painter->setRenderHint(QPainter::Antialiasing);
+
     QRectF frameRect(rect.adjusted(1, 1, -1, -1));
     qreal radius(frameRadius());
 
@@ -871,8 +1287,10 @@ void Helper::renderTabWidgetFrame(QPainter *painter, const QRect &rect, const QC
         painter->setBrush(Qt::NoBrush);
 
     // render
-    QPainterPath path(roundedPath(frameRect, corners, radius));
-    painter->drawPath(path);
+    // translate the painter rather than the path, so that the cached path is used as is
+    painter->translate(frameRect.topLeft());
+    painter->drawPath(roundedPath(QRectF(QPointF(0, 0), frameRect.size()), corners, radius));
+    painter->translate(-frameRect.topLeft());
 }
 
 //______________________________________________________________________________
@@ -881,28 +1299,85 @@ void Helper::renderSelection(QPainter *painter, const QRect &rect, const QColor
     painter->setRenderHint(QPainter::Antialiasing);
     painter->setPen(Qt::NoPen);
     painter->setBrush(color);
-    painter->drawRect(rect);
+    fillRect(painter, rect, color);
 }
 
 //______________________________________________________________________________
 void Helper::renderSeparator(QPainter *painter, const QRect &rect, const QColor &color, bool vertical) const
 {
-    painter->save();
+    const bool antialiasing(painter->testRenderHint(QPainter::Antialiasing));
     painter->setRenderHint(QPainter::Antialiasing, false);
-    painter->setBrush(Qt::NoBrush);
-    painter->setPen(color);
 
     if (vertical) {
-        painter->translate(rect.width() / 2, 0);
-        painter->drawLine(rect.topLeft(), rect.bottomLeft());
+        const QPoint offset(rect.width() / 2, 0);
+        drawLine(painter, rect.topLeft() + offset, rect.bottomLeft() + offset, color);
     } else {
-        painter->translate(0, rect.height() / 2);
-        painter->drawLine(rect.topLeft(), rect.topRight());
+        const QPoint offset(0, rect.height() / 2);
+        drawLine(painter, rect.topLeft() + offset, rect.topRight() + offset, color);
     }
 
-    painter->restore();
+    painter->setRenderHint(QPainter::Antialiasing, antialiasing);
+}
 
-    return;
+//______________________________________________________________________________
+bool Helper::isPixelAligned(const QPainter *painter, const QRectF &rect) const
+{
+    const QTransform &transform(painter->deviceTransform());
+    if (transform.type() > QTransform::TxScale)
+        return false;
+
+    const QRectF deviceRect(transform.mapRect(rect));
+    return isPixelBoundary(deviceRect.left()) && isPixelBoundary(deviceRect.top()) && isPixelBoundary(deviceRect.right())
+        && isPixelBoundary(deviceRect.bottom());
+}
+
+//______________________________________________________________________________
+void Helper::fillRect(QPainter *painter, const QRectF &rect, const QColor &color) const
+{
+    // antialiasing has no effect on aligned rects, but forces the rasterizer on its slow path
+    const bool antialiasing(painter->testRenderHint(QPainter::Antialiasing));
+    if (antialiasing && isPixelAligned(painter, rect)) {
+        painter->setRenderHint(QPainter::Antialiasing, false);
+        painter->fillRect(rect, color);
+        painter->setRenderHint(QPainter::Antialiasing, true);
+    } else {
+        painter->fillRect(rect, color);
+    }
+}
+
+//______________________________________________________________________________
+void Helper::drawLine(QPainter *painter, const QPointF &p1, const QPointF &p2, const QColor &color) const
+{
+    const bool horizontal(p1.y() == p2.y());
+    const bool vertical(p1.x() == p2.x());
+    if (horizontal || vertical) {
+        const QPointF topLeft(qMin(p1.x(), p2.x()), qMin(p1.y(), p2.y()));
+        const QPointF bottomRight(qMax(p1.x(), p2.x()), qMax(p1.y(), p2.y()));
+
+        if (painter->testRenderHint(QPainter::Antialiasing)) {
+            // the stroke of a square capped, one pixel wide line covers the line extended by half a pixel on all sides
+            const QRectF rect(QRectF(topLeft, bottomRight).adjusted(-0.5, -0.5, 0.5, 0.5));
+            if (isPixelAligned(painter, rect)) {
+                fillRect(painter, rect, color);
+                return;
+            }
+
+        } else {
+            // aliased lines between integer positions cover the pixels from first to last point, provided that there is no scaling
+            const QTransform &transform(painter->deviceTransform());
+            if (transform.type() <= QTransform::TxTranslate && isPixelBoundary(transform.dx()) && isPixelBoundary(transform.dy())
+                && isPixelBoundary(topLeft.x()) && isPixelBoundary(topLeft.y()) && isPixelBoundary(bottomRight.x()) && isPixelBoundary(bottomRight.y())) {
+                painter->fillRect(QRect(topLeft.toPoint(), bottomRight.toPoint()), color);
+                return;
+            }
+        }
+    }
+
+    // generic case
+    const QPen pen(painter->pen());
+    painter->setPen(color);
+    painter->drawLine(p1, p2);
+    painter->setPen(pen);
 }
 
 //______________________________________________________________________________
@@ -923,6 +1398,28 @@ void Helper::renderCheckBoxBackground(QPainter *painter, const QRect &rect, cons
 //______________________________________________________________________________
 void Helper::renderCheckBox(QPainter *painter, const QRect &rect, const QColor &background, const QColor &outline, const QColor &tickColor,
                             bool sunken, CheckBoxState state, bool mouseOver, const QPalette &palette, qreal animation, bool active, bool inMenu) const
+{
+    // animated marks are cached for each animation step
+    const int step(state == CheckAnimated ? indicatorAnimationStep(animation) : 0);
+    if (step >= 0) {
+        FrameCacheKey key(FrameCheckBoxIndicator, rect.size(),
+                          state | (sunken << 2) | (mouseOver << 3) | (active << 4) | (inMenu << 5) | (palette.currentColorGroup() << 6) | (step << 8),
+                          background, outline, tickColor);
+        key.setPaletteColors(palette);
+        auto render = [=](QPainter *painter, const QRect &rect) {
+            paintCheckBox(painter, rect, background, outline, tickColor, sunken, state, mouseOver, palette, animation, active, inMenu);
+        };
+
+        if (renderCachedFrame(painter, rect, key, render))
+            return;
+    }
+
+    paintCheckBox(painter, rect, background, outline, tickColor, sunken, state, mouseOver, palette, animation, active, inMenu);
+}
+
+//______________________________________________________________________________
+void Helper::paintCheckBox(QPainter *painter, const QRect &rect, const QColor &background, const QColor &outline, const QColor &tickColor,
+                           bool sunken, CheckBoxState state, bool mouseOver, const QPalette &palette, qreal animation, bool active, bool inMenu) const
 {
     // setup painter
     painter->save();
@@ -1013,6 +1510,30 @@ void Helper::renderRadioButton(QPainter *painter, const QRect &rect, const QColo
     // setup painter
     painter->setRenderHint(QPainter::Antialiasing, true);
 
+    // animated marks are cached for each animation step
+    const int step(state == RadioAnimated ? indicatorAnimationStep(animation) : 0);
+    if (step >= 0) {
+        FrameCacheKey key(FrameRadioButtonIndicator, rect.size(), state | (inMenu << 2) | (palette.currentColorGroup() << 6) | (step << 8),
+                          background, outline, tickColor);
+        key.setPaletteColors(palette);
+        auto render = [=](QPainter *painter, const QRect &rect) {
+            paintRadioButton(painter, rect, background, outline, tickColor, state, palette, animation, inMenu);
+        };
+
+        if (renderCachedFrame(painter, rect, key, render))
+            return;
+    }
+
+    paintRadioButton(painter, rect, background, outline, tickColor, state, palette, animation, inMenu);
+}
+
+//______________________________________________________________________________
+void Helper::paintRadioButton(QPainter *painter, const QRect &rect, const QColor &background, const QColor &outline, const QColor &tickColor,
+                              RadioButtonState state, const QPalette &palette, qreal animation, bool inMenu) const
+{
+    // setup painter
+    painter->setRenderHint(QPainter::Antialiasing, true);
+
     // copy rect
     QRectF frameRect(rect);
     frameRect.adjust(2, 2, -2, -2);
@@ -1041,10 +1562,7 @@ void Helper::renderRadioButton(QPainter *painter, const QRect &rect, const QColo
         }
     } else {
         if (background.isValid()) {
-            QLinearGradient gradient(frameRect.bottomLeft(), frameRect.topLeft());
-            gradient.setColorAt(0, darken(background, 0.014));
-            gradient.setColorAt(1, background);
-            painter->setBrush(gradient);
+            painter->setBrush(gradientBrush(darken(background, 0.014), background));
         } else {
             painter->setBrush(Qt::NoBrush);
         }
@@ -1166,18 +1684,14 @@ void Helper::renderSliderHandle(QPainter *painter, const QRect &rect, const QCol
 
     // set brush
     if (color.isValid() && enabled) {
-        QLinearGradient gradient(frameRect.bottomLeft(), frameRect.topLeft());
         if (sunken) {
             // Pressed-alt button in normal and dark mode is not a gradient, just an image consting from same $background
-            gradient.setColorAt(0, color);
-            gradient.setColorAt(1, color);
+            painter->setBrush(color);
         } else {
             QColor baseColor = darken(color, 0.05);
             // Normal-alt button in normal mode is a gradient from $color to bg_background
-            gradient.setColorAt(0, baseColor);
-            gradient.setColorAt(1, color);
+            painter->setBrush(gradientBrush(baseColor, color));
         }
-        painter->setBrush(gradient);
     }  else if (!enabled) {
         painter->setBrush(color);
     } else {
@@ -1354,8 +1868,22 @@ void Helper::renderTabBarTab(QPainter *painter, const QRect &rect, const QColor
 }
 
 //______________________________________________________________________________
-// TODO blurry edges
 void Helper::renderArrow(QPainter *painter, const QRect &rect, const QColor &color, ArrowOrientation orientation) const
+{
+    // glyphs are cached with a margin, so that nothing painted outside of rect is lost
+    const QRect glyphRect(rect.adjusted(-glyphMargin, -glyphMargin, glyphMargin, glyphMargin));
+    FrameCacheKey key(FrameArrow, glyphRect.size(), orientation, color);
+    auto render = [=](QPainter *painter, const QRect &rect) {
+        paintArrow(painter, rect.adjusted(glyphMargin, glyphMargin, -glyphMargin, -glyphMargin), color, orientation);
+    };
+
+    if (!renderCachedFrame(painter, glyphRect, key, render))
+        paintArrow(painter, rect, color, orientation);
+}
+
+//______________________________________________________________________________
+// TODO blurry edges
+void Helper::paintArrow(QPainter *painter, const QRect &rect, const QColor &color, ArrowOrientation orientation) const
 {
     // define polygon
     QPolygonF arrow;
@@ -1392,11 +1920,33 @@ void Helper::renderArrow(QPainter *painter, const QRect &rect, const QColor &col
     return;
 }
 
+//______________________________________________________________________________
 void Helper::renderSign(QPainter *painter, const QRect &rect, const QColor &color, bool orientation) const
 {
     QPen pen(color, 2);
     pen.setCapStyle(Qt::FlatCap);
 
+    // signs are rendered with the painter antialiasing hint
+    const bool antialiasing(painter->testRenderHint(QPainter::Antialiasing));
+    const QRect glyphRect(rect.adjusted(-glyphMargin, -glyphMargin, glyphMargin, glyphMargin));
+    FrameCacheKey key(FrameSign, glyphRect.size(), orientation | (antialiasing << 1), color);
+    auto render = [=](QPainter *painter, const QRect &rect) {
+        painter->setRenderHint(QPainter::Antialiasing, antialiasing);
+        paintSign(painter, rect.adjusted(glyphMargin, glyphMargin, -glyphMargin, -glyphMargin), color, orientation);
+    };
+
+    if (renderCachedFrame(painter, glyphRect, key, render))
+        painter->setPen(pen);
+    else
+        paintSign(painter, rect, color, orientation);
+}
+
+//______________________________________________________________________________
+void Helper::paintSign(QPainter *painter, const QRect &rect, const QColor &color, bool orientation) const
+{
+    QPen pen(color, 2);
+    pen.setCapStyle(Qt::FlatCap);
+
     QRect r = rect.adjusted(1, 2, 0, 0);
 
     painter->setPen(pen);
@@ -1407,6 +1957,20 @@ void Helper::renderSign(QPainter *painter, const QRect &rect, const QColor &colo
 
 //______________________________________________________________________________
 void Helper::renderDecorationButton(QPainter *painter, const QRect &rect, const QColor &color, ButtonType buttonType, bool inverted) const
+{
+    // the button replaces the painter window and viewport, which is only equivalent to a blit for untransformed painters
+    if (painter->transform().isIdentity() && !painter->viewTransformEnabled()) {
+        FrameCacheKey key(FrameDecorationButton, rect.size(), buttonType | (inverted << 3), color);
+        auto render = [=](QPainter *painter, const QRect &rect) { paintDecorationButton(painter, rect, color, buttonType, inverted); };
+        if (renderCachedFrame(painter, rect, key, render))
+            return;
+    }
+
+    paintDecorationButton(painter, rect, color, buttonType, inverted);
+}
+
+//______________________________________________________________________________
+void Helper::paintDecorationButton(QPainter *painter, const QRect &rect, const QColor &color, ButtonType buttonType, bool inverted) const
 {
     painter->save();
     painter->setViewport(rect);
@@ -1492,6 +2056,27 @@ QRectF Helper::shadowRect(const QRectF &rect) const
 
 //______________________________________________________________________________
 QPainterPath Helper::roundedPath(const QRectF &rect, Corners corners, qreal radius) const
+{
+    // paths only depend on the rect size, and are built once at the origin
+    const RoundedPathKey key(rect.size(), corners, radius);
+    QPainterPath *path(_roundedPathCache.object(key));
+    if (path) {
+        ++_roundedPathStatistics.hits;
+    } else {
+        ++_roundedPathStatistics.misses;
+        path = new QPainterPath(createRoundedPath(QRectF(QPointF(0, 0), rect.size()), corners, radius));
+        _roundedPathCache.insert(key, path);
+    }
+
+    // copies share data with the cached path, translation detaches
+    if (rect.topLeft().isNull())
+        return *path;
+    else
+        return path->translated(rect.topLeft());
+}
+
+//______________________________________________________________________________
+QPainterPath Helper::createRoundedPath(const QRectF &rect, Corners corners, qreal radius) const
 {
     QPainterPath path;
 
@@ -1626,6 +2211,11 @@ xcb_atom_t Helper::createAtom(const QString &name) const
 //____________________________________________________________________
 void Helper::init(void)
 {
+    _frameCache.setMaxCost(Config::FrameCacheSize);
+    _roundedPathCache.setMaxCost(Config::RoundedPathCacheSize);
+    _paletteColorCache.setMaxCost(Config::PaletteColorCacheSize);
+    _gradientCache.setMaxCost(Config::GradientCacheSize);
+
 #if INSPIRE_HAVE_X11
     if (isX11()) {
         // create compositing screen
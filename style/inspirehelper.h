@@ -29,6 +29,9 @@
 #include <KColorScheme>
 #include <KSharedConfig>
 
+#include <QCache>
+#include <QImage>
+#include <QPainter>
 #include <QPainterPath>
 #include <QStyle>
 #include <QWidget>
@@ -42,7 +45,10 @@
 #include <xcb/xcb.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <iterator>
 
 namespace Inspire
 {
@@ -99,6 +105,13 @@ public:
         return QColor::fromRgbF(r, g, b, a);
     }
 
+    //* interpolate colors in premultiplied rgb space, for animated colors
+    /** unlike mix, a transparent color does not contribute its hue to the result */
+    static QColor interpolate(const QColor &c1, const QColor &c2, qreal bias);
+
+    //* interpolate count premultiplied ARGB32 colors at once, using SIMD instructions when available
+    static void interpolate(const QRgb *c1, const QRgb *c2, QRgb *out, int count, qreal bias);
+
     static QColor lighten(const QColor &color, qreal amount = 0.1)
     {
         qreal h, s, l, a;
@@ -273,6 +286,43 @@ public:
 
     //@}
 
+    //*@name palette color table
+    //@{
+
+    //* static colors derived from a palette, for a given color group
+    struct PaletteColors {
+        QColor frameOutline;
+        QColor indicatorOutlineChecked;
+        QColor indicatorBackgroundSunken;
+        QColor indicatorBackgroundHover;
+        QColor indicatorBackgroundDisabled;
+        QColor buttonBackgroundDisabledSunken;
+        QColor arrowText;
+        QColor arrowWindowText;
+        QColor arrowButtonText;
+        QColor sliderOutline;
+        QColor checkBoxIndicatorInactive;
+    };
+
+    //* derived colors for palette and color group
+    /**
+    colors are cached by the palette colors they derive from, so that modified palette copies,
+    such as item view or enable transition palettes, share entries. Returned by value, since the cache may drop entries on insertion
+    */
+    PaletteColors paletteColors(const QPalette &palette, QPalette::ColorGroup group) const;
+
+    //* vertical gradient brush, from bottom to top of the painted object
+    /** brushes use object bounding mode and are cached by stop colors, so that they are shared across widgets and frames */
+    QBrush gradientBrush(const QColor &bottom, const QColor &top) const;
+
+    //* derived colors for palette current color group
+    PaletteColors paletteColors(const QPalette &palette) const
+    {
+        return paletteColors(palette, palette.currentColorGroup());
+    }
+
+    //@}
+
     //*@name rendering utilities
     //@{
 
@@ -392,6 +442,74 @@ public:
 
     //@}
 
+    //*@name pixel aligned geometry
+    //@{
+
+    //* true if rect edges fall on device pixel boundaries with the painter current transformation
+    bool isPixelAligned(const QPainter *painter, const QRectF &rect) const;
+
+    //* fill rect with color. Pixel aligned rects are filled without antialiasing, which is exact and faster
+    /** painter state is left unchanged */
+    void fillRect(QPainter *painter, const QRectF &rect, const QColor &color) const;
+
+    //* draw horizontal or vertical line with a one pixel wide, square capped pen, as the rect it covers whenever possible
+    /** painter state is left unchanged */
+    void drawLine(QPainter *painter, const QPointF &p1, const QPointF &p2, const QColor &color) const;
+
+    //@}
+
+    //*@name frame cache
+    //@{
+
+    //* frame primitives rendered through the pixmap cache
+    enum FramePrimitive {
+        FrameGeneric,
+        FrameButton,
+        FrameFlatButton,
+        FrameCheckBox,
+        FrameMenu,
+        FrameTooltip,
+        FrameTabWidget,
+        FrameCheckBoxIndicator,
+        FrameRadioButtonIndicator,
+        FrameArrow,
+        FrameSign,
+        FrameDecorationButton,
+        FramePrimitiveCount
+    };
+
+    //* cache hit and miss counters
+    struct CacheStatistics {
+        quint64 hits = 0;
+        quint64 misses = 0;
+    };
+
+    //* cache statistics for a given frame primitive
+    const CacheStatistics &frameCacheStatistics(FramePrimitive primitive) const
+    {
+        return _frameCacheStatistics[primitive];
+    }
+
+    //* true if offscreen primitives are rendered to QImage rather than QPixmap
+    bool imageBackend() const
+    {
+        return _imageBackend;
+    }
+
+    //* select offscreen rendering backend. Drops cached primitives when changed
+    void setImageBackend(bool value);
+
+    //* rounded path statistics. Misses count path allocations
+    const CacheStatistics &roundedPathStatistics() const
+    {
+        return _roundedPathStatistics;
+    }
+
+    //* drop all cached pixmaps and paths
+    void invalidateCaches();
+
+    //@}
+
     //*@name compositing utilities
     //@{
 
@@ -468,10 +586,202 @@ protected:
     QRectF shadowRect(const QRectF &) const;
 
     //* return rounded path in a given rect, with only selected corners rounded, and for a given radius
+    /** the path is shared with the path cache when rect is at the origin, and translated otherwise */
     QPainterPath roundedPath(const QRectF &, Corners, qreal) const;
 
+    //* build rounded path, bypassing the path cache
+    QPainterPath createRoundedPath(const QRectF &, Corners, qreal) const;
+
+public:
+
+    //* frame cache key
+    /** colors are interpreted depending on the primitive. Invalid colors are flagged separately so that they do not collide with black */
+    struct FrameCacheKey {
+        FrameCacheKey(FramePrimitive primitive, const QSize &size, uint flags,
+                      const QColor &color0 = QColor(), const QColor &color1 = QColor(), const QColor &color2 = QColor(), const QColor &color3 = QColor())
+            : primitive(primitive)
+            , size(size)
+            , devicePixelRatio(1.0)
+            , flags(flags)
+            , palette{0, 0, 0}
+        {
+            const QColor colors[] = { color0, color1, color2, color3 };
+            for (int i = 0; i < 4; ++i) {
+                if (colors[i].isValid()) {
+                    rgba[i] = colors[i].rgba();
+                    this->flags |= (1 << (24 + i));
+                } else {
+                    rgba[i] = 0;
+                }
+            }
+        }
+
+        bool operator==(const FrameCacheKey &other) const
+        {
+            return primitive == other.primitive
+                   && size == other.size
+                   && devicePixelRatio == other.devicePixelRatio
+                   && flags == other.flags
+                   && palette[0] == other.palette[0]
+                   && palette[1] == other.palette[1]
+                   && palette[2] == other.palette[2]
+                   && rgba[0] == other.rgba[0]
+                   && rgba[1] == other.rgba[1]
+                   && rgba[2] == other.rgba[2]
+                   && rgba[3] == other.rgba[3];
+        }
+
+        FramePrimitive primitive;
+        QSize size;
+        qreal devicePixelRatio;
+        uint flags;
+
+        //* text, highlight and base colors, for indicators that read them from the palette directly
+        void setPaletteColors(const QPalette &palette)
+        {
+            this->palette[0] = palette.color(QPalette::Text).rgba();
+            this->palette[1] = palette.color(QPalette::Highlight).rgba();
+            this->palette[2] = palette.color(QPalette::Base).rgba();
+        }
+
+        QRgb palette[3];
+
+        QRgb rgba[4];
+    };
+
+    //* palette color cache key, made of the palette colors the derived colors are built from
+    struct PaletteColorKey {
+        PaletteColorKey(const QPalette &palette, QPalette::ColorGroup group)
+            : rgba{palette.color(group, QPalette::Window).rgba(),
+                   palette.color(group, QPalette::Highlight).rgba(),
+                   palette.color(group, QPalette::Base).rgba(),
+                   palette.color(group, QPalette::Text).rgba(),
+                   palette.color(group, QPalette::WindowText).rgba(),
+                   palette.color(group, QPalette::ButtonText).rgba(),
+                   palette.color(group, QPalette::Button).rgba(),
+                   palette.color(group, QPalette::Shadow).rgba(),
+                   palette.color(QPalette::Active, QPalette::Window).rgba(),
+                   palette.color(QPalette::Active, QPalette::Base).rgba(),
+                   palette.color(QPalette::Active, QPalette::Highlight).rgba()}
+        {}
+
+        bool operator==(const PaletteColorKey &other) const
+        {
+            return std::equal(std::begin(rgba), std::end(rgba), std::begin(other.rgba));
+        }
+
+        QRgb rgba[11];
+    };
+
+    //* rounded path cache key
+    struct RoundedPathKey {
+        RoundedPathKey(const QSizeF &size, Corners corners, qreal radius)
+            : size(size)
+            , corners(corners)
+            , radius(radius)
+        {}
+
+        bool operator==(const RoundedPathKey &other) const
+        {
+            return size == other.size && corners == other.corners && radius == other.radius;
+        }
+
+        QSizeF size;
+        Corners corners;
+        qreal radius;
+    };
+
 private:
 
+    //* uncached frame rendering
+    //@{
+    void paintFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline, bool hasFocus) const;
+    void paintButtonFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline, bool sunken, bool mouseOver, bool active, const QPalette &palette) const;
+    void paintCheckBoxFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline, const QPalette &palette, CheckBoxState state, bool inMenu) const;
+    void paintFlatButtonFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline, bool sunken, bool active) const;
+    void paintMenuFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline, const QPalette &palette) const;
+    void paintTooltipFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline) const;
+    void paintTabWidgetFrame(QPainter *painter, const QRect &rect, const QColor &color, const QColor &outline, Corners) const;
+    void paintCheckBox(QPainter *painter, const QRect &rect, const QColor &background, const QColor &outline, const QColor &tickColor, bool sunken, CheckBoxState state, bool mouseOver, const QPalette &palette, qreal animation, bool active, bool inMenu) const;
+    void paintRadioButton(QPainter *painter, const QRect &rect, const QColor &background, const QColor &outline, const QColor &tickColor, RadioButtonState state, const QPalette &palette, qreal animation, bool inMenu) const;
+    void paintArrow(QPainter *painter, const QRect &rect, const QColor &color, ArrowOrientation orientation) const;
+    void paintSign(QPainter *painter, const QRect &rect, const QColor &color, bool orientation) const;
+    void paintDecorationButton(QPainter *painter, const QRect &rect, const QColor &color, ButtonType buttonType, bool inverted) const;
+    //@}
+
+    //* animation step for indicator sprites, or -1 if the animation value is not quantized
+    int indicatorAnimationStep(qreal animation) const;
+
+    //* true if frames painted with this painter can be blitted from cache. Returns the device pixel ratio to render at
+    bool canCacheFrame(QPainter *painter, const QRect &rect, qreal *devicePixelRatio) const;
+
+    //* cached frame, stored as pixmap or image depending on the offscreen backend
+    struct CachedFrame {
+        QPixmap pixmap;
+        QImage image;
+
+        //* cost in kilobytes
+        int cost() const
+        {
+            const QSize size(image.isNull() ? pixmap.size() : image.size());
+            return qMax(1, size.width() * size.height() * 4 / 1024);
+        }
+
+        //* draw whole frame
+        void draw(QPainter *painter, const QPoint &position) const
+        {
+            if (image.isNull())
+                painter->drawPixmap(position, pixmap);
+            else
+                painter->drawImage(position, image);
+        }
+
+        //* draw part of the frame. Source is in device pixels
+        void draw(QPainter *painter, const QRectF &target, const QRectF &source) const
+        {
+            if (image.isNull())
+                painter->drawPixmap(target, pixmap, source);
+            else
+                painter->drawImage(target, image, source);
+        }
+    };
+
+    //* return cached frame matching key, rendering it if needed
+    CachedFrame cachedFrame(const FrameCacheKey &key, const std::function<void(QPainter *, const QRect &)> &render) const;
+
+    //* render a frame primitive through the pixmap cache
+    /**
+    frames too large to be cached as a whole are composed from a cached tile of minimal size, when stretchable.
+    The tile corners are drawn as is, and its one pixel wide middle row and column are stretched over the frame edges and center.
+    Returns false if the painter state does not allow caching, in which case nothing is rendered
+    */
+    bool renderCachedFrame(QPainter *painter, const QRect &rect, FrameCacheKey key, const std::function<void(QPainter *, const QRect &)> &render,
+                           Qt::Orientations stretch = 0) const;
+
+    //* build derived colors for palette and color group
+    PaletteColors createPaletteColors(const QPalette &palette, QPalette::ColorGroup group) const;
+
+    //* derived colors, by source colors
+    mutable QCache<PaletteColorKey, PaletteColors> _paletteColorCache;
+
+    //* frame cache
+    mutable QCache<FrameCacheKey, CachedFrame> _frameCache;
+
+    //* frame cache statistics
+    mutable CacheStatistics _frameCacheStatistics[FramePrimitiveCount];
+
+    //* offscreen rendering backend
+    bool _imageBackend = false;
+
+    //* gradient brushes, by bottom and top colors
+    mutable QCache<quint64, QBrush> _gradientCache;
+
+    //* rounded paths, located at the origin
+    mutable QCache<RoundedPathKey, QPainterPath> _roundedPathCache;
+
+    //* rounded path statistics
+    mutable CacheStatistics _roundedPathStatistics;
+
 #if INSPIRE_HAVE_X11
 
     //* atom used for compositing manager
@@ -481,6 +791,48 @@ private:
 
 };
 
+//* hash for frame cache keys
+inline uint qHash(const Helper::FrameCacheKey &key, uint seed = 0)
+{
+    uint hash(seed ^ uint(key.primitive));
+    auto combine = [&hash](uint value) {
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    };
+
+    combine(uint(key.size.width()));
+    combine(uint(key.size.height()));
+    combine(uint(qRound(key.devicePixelRatio * 100)));
+    combine(key.flags);
+    for (QRgb rgba : key.palette)
+        combine(rgba);
+    for (QRgb rgba : key.rgba)
+        combine(rgba);
+    return hash;
+}
+
+//* hash for palette color keys
+inline uint qHash(const Helper::PaletteColorKey &key, uint seed = 0)
+{
+    uint hash(seed);
+    for (QRgb rgba : key.rgba)
+        hash ^= rgba + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+//* hash for rounded path keys
+inline uint qHash(const Helper::RoundedPathKey &key, uint seed = 0)
+{
+    uint hash(seed ^ uint(key.corners));
+    auto combine = [&hash](uint value) {
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    };
+
+    combine(qHash(key.size.width()));
+    combine(qHash(key.size.height()));
+    combine(qHash(key.radius));
+    return hash;
+}
+
 }
 
 #endif
@@ -0,0 +1,79 @@
+/*************************************************************************
+ * Copyright (C) 2026 Inspire contributors                               *
+ *                                                                       *
+ * This program is free software; you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation; either version 2 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program; if not, write to the                         *
+ * Free Software Foundation, Inc.,                                       *
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA .        *
+ *************************************************************************/
+
+#include "inspirepainterstateguard.h"
+
+#include <QStringList>
+#include <QtGlobal>
+
+namespace Inspire
+{
+
+//____________________________________________________________________
+bool PainterStateGuard::checkEnabled()
+{
+    // comparing the full state on every guard is expensive, so the check is opt-in
+    static const bool enabled(qEnvironmentVariableIsSet("INSPIRE_CHECK_PAINTER_STATE"));
+    return enabled;
+}
+
+//____________________________________________________________________
+PainterStateGuard::Snapshot::Snapshot(const QPainter *painter)
+    : pen(painter->pen())
+    , brush(painter->brush())
+    , renderHints(painter->renderHints())
+    , brushOrigin(painter->brushOrigin())
+    , font(painter->font())
+    , hasClipping(painter->hasClipping())
+    , clipBoundingRect(painter->hasClipping() ? painter->clipBoundingRect() : QRectF())
+    , transform(painter->worldTransform())
+    , opacity(painter->opacity())
+    , compositionMode(painter->compositionMode())
+{
+}
+
+//____________________________________________________________________
+void PainterStateGuard::checkLeaks() const
+{
+    const Snapshot current(_painter);
+    const Snapshot &snapshot(*_snapshot);
+    QStringList leaks;
+
+    if (!(_states & Pen) && current.pen != snapshot.pen)
+        leaks.append(QStringLiteral("pen"));
+    if (!(_states & Brush) && current.brush != snapshot.brush)
+        leaks.append(QStringLiteral("brush"));
+    if (!(_states & RenderHints) && current.renderHints != snapshot.renderHints)
+        leaks.append(QStringLiteral("render hints"));
+    if (!(_states & BrushOrigin) && current.brushOrigin != snapshot.brushOrigin)
+        leaks.append(QStringLiteral("brush origin"));
+    if (current.font != snapshot.font)
+        leaks.append(QStringLiteral("font"));
+    if (current.hasClipping != snapshot.hasClipping || current.clipBoundingRect != snapshot.clipBoundingRect)
+        leaks.append(QStringLiteral("clip"));
+    if (current.transform != snapshot.transform)
+        leaks.append(QStringLiteral("transform"));
+    if (current.opacity != snapshot.opacity || current.compositionMode != snapshot.compositionMode)
+        leaks.append(QStringLiteral("other"));
+
+    if (!leaks.isEmpty())
+        qWarning("Inspire::PainterStateGuard - undeclared painter state modified: %s", qPrintable(leaks.join(QStringLiteral(", "))));
+}
+
+}
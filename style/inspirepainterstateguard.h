@@ -0,0 +1,165 @@
+#ifndef inspirepainterstateguard_h
+#define inspirepainterstateguard_h
+
+/*************************************************************************
+ * Copyright (C) 2026 Inspire contributors                               *
+ *                                                                       *
+ * This program is free software; you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation; either version 2 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program; if not, write to the                         *
+ * Free Software Foundation, Inc.,                                       *
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA .        *
+ *************************************************************************/
+
+#include <QBrush>
+#include <QFont>
+#include <QPainter>
+#include <QPen>
+
+namespace Inspire
+{
+
+//* restores the painter state a primitive declares it modifies, when going out of scope
+/**
+pen, brush, render hints and brush origin are recorded and restored individually.
+Clip, transform, font and anything else go through QPainter::save and restore, which copy the whole state.
+When the INSPIRE_CHECK_PAINTER_STATE environment variable is set, state that was not declared is checked on destruction,
+and a warning is printed if it changed
+*/
+class PainterStateGuard
+{
+public:
+    //* painter state
+    enum State {
+        None = 0,
+        Pen = 0x1,
+        Brush = 0x2,
+        RenderHints = 0x4,
+        BrushOrigin = 0x8,
+        Clip = 0x10,
+        Transform = 0x20,
+        Other = 0x40,
+
+        //* state set by Helper render functions
+        Paint = Pen | Brush | RenderHints,
+        All = Pen | Brush | RenderHints | BrushOrigin | Clip | Transform | Other
+    };
+    Q_DECLARE_FLAGS(States, State)
+
+    //* state recorded individually
+    static constexpr int Recorded = Pen | Brush | RenderHints | BrushOrigin;
+
+    //* constructor
+    PainterStateGuard(QPainter *painter, States states)
+        : _painter(painter)
+        , _states(states)
+    {
+        if (_states & ~Recorded) {
+            _painter->save();
+            _saved = true;
+            return;
+        }
+
+        if (_states & Pen)
+            _pen = _painter->pen();
+        if (_states & Brush)
+            _brush = _painter->brush();
+        if (_states & RenderHints)
+            _renderHints = _painter->renderHints();
+        if (_states & BrushOrigin)
+            _brushOrigin = _painter->brushOrigin();
+
+        if (checkEnabled())
+            _snapshot = new Snapshot(_painter);
+    }
+
+    //* destructor
+    ~PainterStateGuard()
+    {
+        if (_saved) {
+            _painter->restore();
+            if (_states & ~Recorded)
+                return;
+        }
+
+        if (_snapshot) {
+            checkLeaks();
+            delete _snapshot;
+        }
+
+        if (_states & Pen)
+            _painter->setPen(_pen);
+        if (_states & Brush)
+            _painter->setBrush(_brush);
+        if (_states & RenderHints) {
+            const QPainter::RenderHints changed(_painter->renderHints() ^ _renderHints);
+            if (changed) {
+                _painter->setRenderHints(changed & _renderHints, true);
+                _painter->setRenderHints(changed & ~_renderHints, false);
+            }
+        }
+        if (_states & BrushOrigin)
+            _painter->setBrushOrigin(_brushOrigin);
+    }
+
+    //* fully save painter state from now on, before handing the painter to code whose modifications are unknown
+    void saveAll()
+    {
+        if (_saved)
+            return;
+        _painter->save();
+        _saved = true;
+    }
+
+private:
+    Q_DISABLE_COPY(PainterStateGuard)
+
+    //* painter state, compared on destruction when checking is enabled
+    struct Snapshot {
+        explicit Snapshot(const QPainter *painter);
+
+        QPen pen;
+        QBrush brush;
+        QPainter::RenderHints renderHints;
+        QPoint brushOrigin;
+        QFont font;
+        bool hasClipping = false;
+        QRectF clipBoundingRect;
+        QTransform transform;
+        qreal opacity = 1;
+        QPainter::CompositionMode compositionMode = QPainter::CompositionMode_SourceOver;
+    };
+
+    //* true if undeclared state changes are checked, read once from the environment
+    static bool checkEnabled();
+
+    //* warn about modified state that was not declared
+    void checkLeaks() const;
+
+    QPainter *_painter;
+    States _states;
+    bool _saved = false;
+
+    QPen _pen;
+    QBrush _brush;
+    QPainter::RenderHints _renderHints;
+    QPoint _brushOrigin;
+
+    //* state on construction, only recorded when checking is enabled
+    Snapshot *_snapshot = nullptr;
+};
+
+}
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(Inspire::PainterStateGuard::States)
+
+#endif
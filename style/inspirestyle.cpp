@@ -25,7 +25,10 @@
 #include "inspireanimations.h"
 #include "inspirehelper.h"
 #include "inspiremnemonics.h"
+#include "inspirepainterstateguard.h"
 #include "inspiresplitterproxy.h"
+#include "inspirewidgetkind.h"
+#include "inspiretransitionwidget.h"
 #include "inspirewindowmanager.h"
 #include "inspireblurhelper.h"
 
@@ -53,15 +56,20 @@
 #include <QPushButton>
 #include <QRadioButton>
 #include <QScrollBar>
+#include <QSet>
 #include <QSpinBox>
 #include <QItemDelegate>
+#include <QItemSelectionModel>
 #include <QSplitterHandle>
 #include <QTextEdit>
+#include <QTextLayout>
 #include <QToolBar>
 #include <QToolBox>
 #include <QToolButton>
 #include <QWidgetAction>
 
+#include <limits>
+
 namespace InspirePrivate
 {
 
@@ -104,6 +112,113 @@ private:
 
 };
 
+//* selection state of widgets embedded in item views, to avoid mapping them to an index on every paint
+class SelectionData: public QObject
+{
+
+public:
+
+    //* constructor
+    explicit SelectionData(QObject *parent)
+        : QObject(parent)
+    {}
+
+    //* destructor
+    virtual ~SelectionData(void)
+    {}
+
+    //* true if the item at position, holding widget, is selected
+    /**
+    widgets set with QAbstractItemView::setIndexWidget, including editors, keep their index.
+    Their selection state is cached until the selection, selection model or model changes. Other widgets are looked up every time
+    */
+    bool isSelected(const QAbstractItemView *itemView, const QWidget *widget, const QPoint &position)
+    {
+        QItemSelectionModel *selectionModel(itemView->selectionModel());
+
+        // cached index
+        auto iter(_widgets.find(widget));
+        if (iter != _widgets.end() && iter->itemView == itemView && iter->selectionModel.data() == selectionModel && iter->index.isValid()
+            && itemView->indexWidget(iter->index) == widget) {
+            if (iter->generation != _generation) {
+                iter->selected = selectionModel->isSelected(iter->index);
+                iter->generation = _generation;
+            }
+
+            return iter->selected;
+        }
+
+        // get matching QModelIndex and check
+        const QModelIndex index(itemView->indexAt(position));
+        if (!index.isValid())
+            return false;
+
+        const bool selected(selectionModel->isSelected(index));
+        if (widget != itemView && itemView->indexWidget(index) == widget) {
+            watch(selectionModel);
+            watch(itemView->model());
+            if (iter == _widgets.end())
+                connect(widget, &QObject::destroyed, this, &SelectionData::unregisterWidget);
+            _widgets.insert(widget, {itemView, selectionModel, index, _generation, selected});
+        }
+
+        return selected;
+    }
+
+private:
+
+    //* connect to selection and model changes, once
+    void watch(QObject *object)
+    {
+        if (!object || _watched.contains(object))
+            return;
+
+        _watched.insert(object);
+        connect(object, &QObject::destroyed, this, &SelectionData::unwatch);
+        if (QItemSelectionModel *selectionModel = qobject_cast<QItemSelectionModel *>(object))
+            connect(selectionModel, &QItemSelectionModel::selectionChanged, this, &SelectionData::invalidate);
+        else if (QAbstractItemModel *model = qobject_cast<QAbstractItemModel *>(object))
+            connect(model, &QAbstractItemModel::modelReset, this, &SelectionData::invalidate);
+    }
+
+    //* object destroyed
+    void unwatch(QObject *object)
+    {
+        _watched.remove(object);
+    }
+
+    //* widget destroyed
+    void unregisterWidget(QObject *object)
+    {
+        _widgets.remove(object);
+    }
+
+    //* selection or model changed, cached selection states are outdated
+    void invalidate(void)
+    {
+        ++_generation;
+    }
+
+    //* cached index and selection state
+    struct WidgetData {
+        const QAbstractItemView *itemView;
+        Inspire::WeakPointer<QItemSelectionModel> selectionModel;
+        QPersistentModelIndex index;
+        quint32 generation;
+        bool selected;
+    };
+
+    //* widgets
+    QHash<const QObject *, WidgetData> _widgets;
+
+    //* selection models and models connected to
+    QSet<const QObject *> _watched;
+
+    //* incremented on every selection or model change
+    quint32 _generation = 0;
+
+};
+
 //* needed to have spacing added to items in combobox
 class ComboBoxItemDelegate: public QItemDelegate
 {
@@ -155,6 +270,162 @@ private:
     int _itemMargin;
 };
 
+//*@name compile time lookup tables for option and widget independent metrics and hints
+//@{
+
+//* metric or hint value
+struct StyleEntry {
+    int key;
+    int value;
+};
+
+//* returned for metrics and hints that are not in a table
+constexpr int Unhandled = std::numeric_limits<int>::min();
+
+//* value matching key in entries
+constexpr int entryValue(const StyleEntry *entries, int count, int key)
+{
+    return count == 0 ? Unhandled : entries->key == key ? entries->value : entryValue(entries + 1, count - 1, key);
+}
+
+//* largest key in entries
+constexpr int maxEntryKey(const StyleEntry *entries, int count, int current = -1)
+{
+    return count == 0 ? current : maxEntryKey(entries + 1, count - 1, entries->key > current ? entries->key : current);
+}
+
+//* compile time integer sequence
+template<int... Index> struct IndexSequence {};
+template<int Count, int... Index> struct MakeIndexSequence : MakeIndexSequence<Count - 1, Count - 1, Index...> {};
+template<int... Index> struct MakeIndexSequence<0, Index...> {
+    using Type = IndexSequence<Index...>;
+};
+
+//* dense table, indexed by key, generated from entries
+template<const StyleEntry *Entries, int Count, typename Sequence = typename MakeIndexSequence<maxEntryKey(Entries, Count) + 1>::Type>
+struct StyleTable;
+
+template<const StyleEntry *Entries, int Count, int... Index>
+struct StyleTable<Entries, Count, IndexSequence<Index...>> {
+    //* value for key, Unhandled if not in the table
+    static int value(int key)
+    {
+        return key >= 0 && key < int(sizeof...(Index)) ? values[key] : Unhandled;
+    }
+
+    static constexpr int values[sizeof...(Index)] = {entryValue(Entries, Count, Index)...};
+};
+
+template<const StyleEntry *Entries, int Count, int... Index>
+constexpr int StyleTable<Entries, Count, IndexSequence<Index...>>::values[sizeof...(Index)];
+
+//* pixel metrics that do not depend on option nor widget
+constexpr StyleEntry pixelMetricEntries[] = {
+    // frame width
+    {QStyle::PM_SpinBoxFrameWidth, Inspire::Metrics::SpinBox_FrameWidth},
+    {QStyle::PM_ToolBarFrameWidth, Inspire::Metrics::ToolBar_FrameWidth},
+    {QStyle::PM_ToolTipLabelFrameWidth, Inspire::Metrics::ToolTip_FrameWidth},
+
+    // layout
+    {QStyle::PM_LayoutHorizontalSpacing, Inspire::Metrics::Layout_DefaultSpacing},
+    {QStyle::PM_LayoutVerticalSpacing, Inspire::Metrics::Layout_DefaultSpacing},
+
+    // buttons
+    {QStyle::PM_ButtonDefaultIndicator, 0},
+    {QStyle::PM_ButtonShiftHorizontal, 0},
+    {QStyle::PM_ButtonShiftVertical, 0},
+
+    // menubars
+    {QStyle::PM_MenuBarPanelWidth, 0},
+    {QStyle::PM_MenuBarHMargin, 0},
+    {QStyle::PM_MenuBarVMargin, 0},
+    {QStyle::PM_MenuBarItemSpacing, 0},
+    {QStyle::PM_MenuDesktopFrameWidth, 0},
+
+    // menu buttons
+    {QStyle::PM_MenuButtonIndicator, Inspire::Metrics::MenuButton_IndicatorWidth},
+
+    // toolbars
+    {QStyle::PM_ToolBarHandleExtent, Inspire::Metrics::ToolBar_HandleExtent},
+    {QStyle::PM_ToolBarSeparatorExtent, Inspire::Metrics::ToolBar_SeparatorWidth},
+    {QStyle::PM_ToolBarItemMargin, 0},
+    {QStyle::PM_ToolBarItemSpacing, Inspire::Metrics::ToolBar_ItemSpacing},
+
+    // tabbars
+    {QStyle::PM_TabBarTabShiftVertical, 0},
+    {QStyle::PM_TabBarTabShiftHorizontal, 0},
+    {QStyle::PM_TabBarTabOverlap, Inspire::Metrics::TabBar_TabOverlap},
+    {QStyle::PM_TabBarBaseOverlap, Inspire::Metrics::TabBar_BaseOverlap},
+    {QStyle::PM_TabBarTabHSpace, 2 * Inspire::Metrics::TabBar_TabMarginWidth},
+    {QStyle::PM_TabBarTabVSpace, 2 * Inspire::Metrics::TabBar_TabMarginHeight},
+
+    // scrollbars
+    {QStyle::PM_ScrollBarExtent, Inspire::Metrics::ScrollBar_Extend},
+    {QStyle::PM_ScrollBarSliderMin, Inspire::Metrics::ScrollBar_MinSliderHeight},
+
+    // sliders
+    {QStyle::PM_SliderThickness, Inspire::Metrics::Slider_ControlThickness},
+    {QStyle::PM_SliderControlThickness, Inspire::Metrics::Slider_ControlThickness},
+    {QStyle::PM_SliderLength, Inspire::Metrics::Slider_ControlThickness},
+
+    // checkboxes and radio buttons
+    {QStyle::PM_IndicatorWidth, Inspire::Metrics::CheckBox_Size},
+    {QStyle::PM_IndicatorHeight, Inspire::Metrics::CheckBox_Size},
+    {QStyle::PM_ExclusiveIndicatorWidth, Inspire::Metrics::CheckBox_Size},
+    {QStyle::PM_ExclusiveIndicatorHeight, Inspire::Metrics::CheckBox_Size},
+
+    // list headers
+    {QStyle::PM_HeaderMarkSize, Inspire::Metrics::Header_ArrowSize},
+    {QStyle::PM_HeaderMargin, Inspire::Metrics::Header_MarginWidth},
+
+    // dock widget
+    // return 0 here, since frame is handled directly in polish
+    {QStyle::PM_DockWidgetFrameWidth, 0},
+    {QStyle::PM_DockWidgetTitleMargin, Inspire::Metrics::Frame_FrameWidth},
+    {QStyle::PM_DockWidgetTitleBarButtonMargin, Inspire::Metrics::ToolButton_MarginWidth},
+
+    {QStyle::PM_SplitterWidth, Inspire::Metrics::Splitter_SplitterWidth},
+    {QStyle::PM_DockWidgetSeparatorExtent, Inspire::Metrics::Splitter_SplitterWidth}
+};
+
+using PixelMetricTable = StyleTable<pixelMetricEntries, sizeof(pixelMetricEntries) / sizeof(StyleEntry)>;
+
+//* style hints that do not depend on option nor widget
+constexpr StyleEntry styleHintEntries[] = {
+    {QStyle::SH_ComboBox_ListMouseTracking, true},
+    {QStyle::SH_MenuBar_MouseTracking, true},
+    {QStyle::SH_Menu_MouseTracking, true},
+    {QStyle::SH_Menu_SubMenuPopupDelay, 150},
+    {QStyle::SH_Menu_SloppySubMenus, true},
+
+#if QT_VERSION >= 0x050000
+    {QStyle::SH_Widget_Animate, Inspire::Config::AnimationsEnabled},
+    {QStyle::SH_Menu_SupportsSections, true},
+#endif
+
+    {QStyle::SH_DialogButtonBox_ButtonsHaveIcons, false},
+
+    {QStyle::SH_GroupBox_TextLabelVerticalAlignment, Qt::AlignVCenter},
+    {QStyle::SH_TabBar_Alignment, Inspire::Config::TabBarDrawCenteredTabs ? int(Qt::AlignCenter) : int(Qt::AlignLeft)},
+    {QStyle::SH_ToolBox_SelectedPageTitleBold, false},
+    {QStyle::SH_ScrollBar_MiddleClickAbsolutePosition, true},
+    {QStyle::SH_ScrollView_FrameOnlyAroundContents, false},
+    {QStyle::SH_FormLayoutFormAlignment, int(Qt::AlignLeft) | int(Qt::AlignTop)},
+    {QStyle::SH_FormLayoutLabelAlignment, Qt::AlignRight},
+    {QStyle::SH_FormLayoutFieldGrowthPolicy, QFormLayout::ExpandingFieldsGrow},
+    {QStyle::SH_FormLayoutWrapPolicy, QFormLayout::DontWrapRows},
+    {QStyle::SH_MessageBox_TextInteractionFlags, int(Qt::TextSelectableByMouse) | int(Qt::LinksAccessibleByMouse)},
+    {QStyle::SH_ProgressDialog_CenterCancelButton, false},
+    {QStyle::SH_MessageBox_CenterButtons, false},
+    {QStyle::SH_RequestSoftwareInputPanel, QStyle::RSIP_OnMouseClick},
+    {QStyle::SH_TitleBar_NoBorder, true},
+    {QStyle::SH_DockWidget_ButtonsHaveFrame, false}
+};
+
+using StyleHintTable = StyleTable<styleHintEntries, sizeof(styleHintEntries) / sizeof(StyleEntry)>;
+
+//@}
+
 } // namespace InspirePrivate
 
 void tabLayout(const QStyleOptionTabV3 *opt, const QWidget *widget, QRect *textRect, QRect *iconRect, const QStyle *proxyStyle)
@@ -232,6 +503,7 @@ Style::Style()
     , _windowManager(new WindowManager(this))
     , _splitterFactory(new SplitterFactory(this))
     , _tabBarData(new InspirePrivate::TabBarData(this))
+    , _selectionData(new InspirePrivate::SelectionData(this))
 #if INSPIRE_HAVE_KSTYLE
     , SH_ArgbDndWindow( newStyleHint( QStringLiteral( "SH_ArgbDndWindow" ) ) )
     , CE_CapacityBar( newControlElement( QStringLiteral( "CE_CapacityBar" ) ) )
@@ -263,6 +535,14 @@ Style::Style()
     #else
     connect(qApp, &QApplication::paletteChanged, this, &Style::configurationChanged);
     #endif
+
+    // memoized contents sizes are keyed on fonts, drop them when the application font changes
+    connect(qApp, &QApplication::fontChanged, this, &Style::clearSizeCache);
+
+    // KDE settings changed from System Settings are notified without a configurationChanged call
+    _configWatcher = KConfigWatcher::create(KSharedConfig::openConfig());
+    connect(_configWatcher.data(), &KConfigWatcher::configChanged, this, &Style::kdeConfigChanged);
+
     // call the slot directly; this initial call will set up things that also
     // need to be reset when the system palette changes
     loadConfiguration();
@@ -286,30 +566,31 @@ void Style::polish(QWidget *widget)
     _windowManager->registerWidget(widget);
     _splitterFactory->registerWidget(widget);
 
+    // classes the widget inherits from, cached per class
+    const WidgetKinds kinds(widgetKinds(widget));
+
     // enable mouse over effects for all necessary widgets
-    if (qobject_cast<QAbstractItemView *>(widget)
-        || qobject_cast<QAbstractSpinBox *>(widget)
-        || qobject_cast<QCheckBox *>(widget)
-        || qobject_cast<QComboBox *>(widget)
-        || qobject_cast<QDial *>(widget)
-        || qobject_cast<QLineEdit *>(widget)
-        || qobject_cast<QPushButton *>(widget)
-        || qobject_cast<QRadioButton *>(widget)
-        || qobject_cast<QScrollBar *>(widget)
-        || qobject_cast<QSlider *>(widget)
-        || qobject_cast<QSplitterHandle *>(widget)
-        || qobject_cast<QTabBar *>(widget)
-        || qobject_cast<QTextEdit *>(widget)
-        || qobject_cast<QToolButton *>(widget)
-#if QT_VERSION >= 0x050000
-        || qobject_cast<QHeaderView *>(widget)
-#endif
-        || widget->inherits("KTextEditor::View")) {
+    if (kinds & (KindAbstractItemView
+                 | KindAbstractSpinBox
+                 | KindCheckBox
+                 | KindComboBox
+                 | KindDial
+                 | KindLineEdit
+                 | KindPushButton
+                 | KindRadioButton
+                 | KindScrollBar
+                 | KindSlider
+                 | KindSplitterHandle
+                 | KindTabBar
+                 | KindTextEdit
+                 | KindToolButton
+                 | KindHeaderView
+                 | KindTextEditorView)) {
         widget->setAttribute(Qt::WA_Hover);
     }
 
-    if (qobject_cast<QTabBar *>(widget)) {
-        qobject_cast<QTabBar *>(widget)->setDrawBase(true);
+    if (kinds & KindTabBar) {
+        static_cast<QTabBar *>(widget)->setDrawBase(true);
     }
 
     // enforce translucency for drag and drop window
@@ -319,34 +600,35 @@ void Style::polish(QWidget *widget)
     }
 
     // scrollarea polishing is somewhat complex. It is moved to a dedicated method
-    polishScrollArea(qobject_cast<QAbstractScrollArea *>(widget));
+    if (kinds & KindAbstractScrollArea)
+        polishScrollArea(static_cast<QAbstractScrollArea *>(widget));
 
-    if (QAbstractItemView *itemView = qobject_cast<QAbstractItemView *>(widget)) {
+    if (kinds & KindAbstractItemView) {
         // enable mouse over effects in itemviews' viewport
-        itemView->viewport()->setAttribute(Qt::WA_Hover);
-    } else if (QGroupBox *groupBox = qobject_cast<QGroupBox *>(widget))  {
+        static_cast<QAbstractItemView *>(widget)->viewport()->setAttribute(Qt::WA_Hover);
+    } else if (kinds & KindGroupBox)  {
         // checkable group boxes
-        if (groupBox->isCheckable()) {
-            groupBox->setAttribute(Qt::WA_Hover);
+        if (static_cast<QGroupBox *>(widget)->isCheckable()) {
+            widget->setAttribute(Qt::WA_Hover);
         }
-    } else if (qobject_cast<QAbstractButton *>(widget) && qobject_cast<QDockWidget *>(widget->parent())) {
+    } else if ((kinds & KindAbstractButton) && qobject_cast<QDockWidget *>(widget->parent())) {
         widget->setAttribute(Qt::WA_Hover);
-    } else if (qobject_cast<QAbstractButton *>(widget) && qobject_cast<QToolBox *>(widget->parent())) {
+    } else if ((kinds & KindAbstractButton) && qobject_cast<QToolBox *>(widget->parent())) {
         widget->setAttribute(Qt::WA_Hover);
-    } else if (qobject_cast<QFrame *>(widget) && widget->parent() && widget->parent()->inherits("KTitleWidget")) {
+    } else if ((kinds & KindFrame) && widget->parent() && widget->parent()->inherits("KTitleWidget")) {
         widget->setAutoFillBackground(false);
         if (!Inspire::Config::TitleWidgetDrawFrame) {
             widget->setBackgroundRole(QPalette::Window);
         }
     }
 
-    if (qobject_cast<QScrollBar *>(widget)) {
+    if (kinds & KindScrollBar) {
         // remove opaque painting for scrollbars
         widget->setAttribute(Qt::WA_OpaquePaintEvent, false);
-    } else if (widget->inherits("KTextEditor::View")) {
+    } else if (kinds & KindTextEditorView) {
         addEventFilter(widget);
-    } else if (QToolButton *toolButton = qobject_cast<QToolButton *>(widget)) {
-        if (toolButton->autoRaise()) {
+    } else if (kinds & KindToolButton) {
+        if (static_cast<QToolButton *>(widget)->autoRaise()) {
             // for flat toolbuttons, adjust foreground and background role accordingly
             widget->setBackgroundRole(QPalette::NoRole);
             widget->setForegroundRole(QPalette::WindowText);
@@ -357,33 +639,34 @@ void Style::polish(QWidget *widget)
                 widget->parentWidget()->parentWidget()->inherits("Gwenview::SideBarGroup")) {
             widget->setProperty(PropertyNames::toolButtonAlignment, Qt::AlignLeft);
         }
-    } else if (qobject_cast<QDockWidget *>(widget)) {
+    } else if (kinds & KindDockWidget) {
         // add event filter on dock widgets
         // and alter palette
         widget->setAutoFillBackground(false);
         widget->setContentsMargins(Metrics::Frame_FrameWidth, Metrics::Frame_FrameWidth, Metrics::Frame_FrameWidth, Metrics::Frame_FrameWidth);
         addEventFilter(widget);
-    } else if (qobject_cast<QMdiSubWindow *>(widget)) {
+    } else if (kinds & KindMdiSubWindow) {
         widget->setAutoFillBackground(false);
         addEventFilter(widget);
-    } else if (qobject_cast<QToolBox *>(widget)) {
+    } else if (kinds & KindToolBox) {
         widget->setBackgroundRole(QPalette::NoRole);
         widget->setAutoFillBackground(false);
     } else if (widget->parentWidget() && widget->parentWidget()->parentWidget() && qobject_cast<QToolBox *>(widget->parentWidget()->parentWidget()->parentWidget())) {
         widget->setBackgroundRole(QPalette::NoRole);
         widget->setAutoFillBackground(false);
         widget->parentWidget()->setAutoFillBackground(false);
-    } else if (qobject_cast<QMenu *>(widget)) {
+    } else if (kinds & KindMenu) {
         setTranslucentBackground( widget );
 
         if ( _helper->hasAlphaChannel( widget ) ) {
             _blurHelper->registerWidget( widget->window() );
         }
 #if QT_VERSION >= 0x050000
-    } else if (qobject_cast<QCommandLinkButton *>(widget)) {
+    } else if (kinds & KindCommandLinkButton) {
         addEventFilter(widget);
 #endif
-    } else if (QComboBox *comboBox = qobject_cast<QComboBox *>(widget)) {
+    } else if (kinds & KindComboBox) {
+        QComboBox *comboBox(static_cast<QComboBox *>(widget));
         if (!hasParent(widget, "QWebView")) {
             QAbstractItemView *itemView(comboBox->view());
             if (itemView && itemView->itemDelegate() && itemView->itemDelegate()->inherits("QComboBoxDelegate")) {
@@ -399,19 +682,21 @@ void Style::polish(QWidget *widget)
                 }
             }
         }
-    } else if (widget->inherits("QComboBoxPrivateContainer")) {
+    } else if (kinds & KindComboBoxContainer) {
         addEventFilter(widget);
         setTranslucentBackground(widget);
-    } else if (widget->inherits("QTipLabel")) {
+    } else if (kinds & KindTipLabel) {
         setTranslucentBackground(widget);
-    } else if (QLineEdit *lineEdit = qobject_cast<QLineEdit *>(widget)) {
+    } else if (kinds & KindLineEdit) {
+        QLineEdit *lineEdit(static_cast<QLineEdit *>(widget));
         // Do not use additional margin if the QLineEdit is really small
         const bool useMarginWidth = lineEdit->width() > lineEdit->fontMetrics().width("#####");
         const bool useMarginHeight = lineEdit->height() > lineEdit->fontMetrics().height() + (2 * Metrics::LineEdit_MarginHeight);
         const int marginHeight = useMarginHeight ? Metrics::LineEdit_MarginHeight : 0;
         const int marginWidth = useMarginWidth ? Metrics::LineEdit_MarginWidth : 0;
         lineEdit->setTextMargins(marginWidth, marginHeight, marginWidth, marginHeight);
-    } else if (QSpinBox *spinBox = qobject_cast<QSpinBox *>(widget)) {
+    } else if (kinds & KindSpinBox) {
+        QSpinBox *spinBox(static_cast<QSpinBox *>(widget));
         if (!spinBox->isEnabled()) {
             QPalette pal = spinBox->palette();
             pal.setColor(QPalette::Base, spinBox->palette().color(QPalette::Window));
@@ -424,7 +709,8 @@ void Style::polish(QWidget *widget)
     // HACK to avoid different text color in unfocused views
     // This has a side effect that the view will never grey out, but it's still better then having
     // views greyed out when the application is active
-    if (QPointer<QAbstractItemView> view = qobject_cast<QAbstractItemView *>(widget)) {
+    if (kinds & KindAbstractItemView) {
+        QAbstractItemView *view(static_cast<QAbstractItemView *>(widget));
         QPalette pal = view->palette();
         // TODO keep synced with the standard palette
         const QColor activeTextColor = QColor("#2e3436");
@@ -437,7 +723,7 @@ void Style::polish(QWidget *widget)
     }
 #endif
 
-    if (!widget->parent() || !qobject_cast<QWidget *>(widget->parent()) || qobject_cast<QDialog *>(widget) || qobject_cast<QMainWindow *>(widget)) {
+    if (!widget->parent() || !widget->parent()->isWidgetType() || (kinds & (KindDialog | KindMainWindow))) {
         addEventFilter(widget);
     }
 
@@ -536,6 +822,11 @@ void Style::unpolish(QWidget *widget)
 //______________________________________________________________
 int Style::pixelMetric(PixelMetric metric, const QStyleOption *option, const QWidget *widget) const
 {
+    // constant metrics
+    const int value(InspirePrivate::PixelMetricTable::value(metric));
+    if (value != InspirePrivate::Unhandled)
+        return value;
+
     // handle special cases
     switch (metric) {
 
@@ -565,12 +856,6 @@ int Style::pixelMetric(PixelMetric metric, const QStyleOption *option, const QWi
         const QStyleOptionComboBox *comboBoxOption(qstyleoption_cast< const QStyleOptionComboBox *>(option));
         return comboBoxOption && comboBoxOption->editable ? Metrics::LineEdit_FrameWidth : Metrics::ComboBox_FrameWidth;
     }
-    case PM_SpinBoxFrameWidth:
-        return Metrics::SpinBox_FrameWidth;
-    case PM_ToolBarFrameWidth:
-        return Metrics::ToolBar_FrameWidth;
-    case PM_ToolTipLabelFrameWidth:
-        return Metrics::ToolTip_FrameWidth;
 
     // layout
     case PM_LayoutLeftMargin:
@@ -589,10 +874,6 @@ int Style::pixelMetric(PixelMetric metric, const QStyleOption *option, const QWi
             return Metrics::Layout_ChildMarginWidth;
         }
     }
-    case PM_LayoutHorizontalSpacing:
-        return Metrics::Layout_DefaultSpacing;
-    case PM_LayoutVerticalSpacing:
-        return Metrics::Layout_DefaultSpacing;
 
     // buttons
     case PM_ButtonMargin: {
@@ -603,111 +884,25 @@ int Style::pixelMetric(PixelMetric metric, const QStyleOption *option, const QWi
             return Metrics::Button_MarginWidth;
     }
 
-    case PM_ButtonDefaultIndicator:
-        return 0;
-    case PM_ButtonShiftHorizontal:
-        return 0;
-    case PM_ButtonShiftVertical:
-        return 0;
-
-    // menubars
-    case PM_MenuBarPanelWidth:
-        return 0;
-    case PM_MenuBarHMargin:
-        return 0;
-    case PM_MenuBarVMargin:
-        return 0;
-    case PM_MenuBarItemSpacing:
-        return 0;
-    case PM_MenuDesktopFrameWidth:
-        return 0;
-
     // menu buttons
-    case PM_MenuButtonIndicator:
-        return Metrics::MenuButton_IndicatorWidth;
     case PM_MenuVMargin:
         return _isGNOME ? 0 : 1;
     case PM_MenuHMargin:
         return _isGNOME ? 0 : 1;
 
     // toolbars
-    case PM_ToolBarHandleExtent:
-        return Metrics::ToolBar_HandleExtent;
-    case PM_ToolBarSeparatorExtent:
-        return Metrics::ToolBar_SeparatorWidth;
     case PM_ToolBarExtensionExtent:
         return pixelMetric(PM_SmallIconSize, option, widget) + 2 * Metrics::ToolButton_MarginWidth;
 
-    case PM_ToolBarItemMargin:
-        return 0;
-    case PM_ToolBarItemSpacing:
-        return Metrics::ToolBar_ItemSpacing;
-
     // tabbars
-    case PM_TabBarTabShiftVertical:
-        return 0;
-    case PM_TabBarTabShiftHorizontal:
-        return 0;
-    case PM_TabBarTabOverlap:
-        return Metrics::TabBar_TabOverlap;
-    case PM_TabBarBaseOverlap:
-        return Metrics::TabBar_BaseOverlap;
-    case PM_TabBarTabHSpace:
-        return 2 * Metrics::TabBar_TabMarginWidth;
-    case PM_TabBarTabVSpace:
-        return 2 * Metrics::TabBar_TabMarginHeight;
     case PM_TabCloseIndicatorWidth:
     case PM_TabCloseIndicatorHeight:
         return pixelMetric(PM_SmallIconSize, option, widget);
 
-    // scrollbars
-    case PM_ScrollBarExtent:
-        return Metrics::ScrollBar_Extend;
-    case PM_ScrollBarSliderMin:
-        return Metrics::ScrollBar_MinSliderHeight;
-
     // title bar
     case PM_TitleBarHeight:
         return 2 * Metrics::TitleBar_MarginWidth + pixelMetric(PM_SmallIconSize, option, widget);
 
-    // sliders
-    case PM_SliderThickness:
-        return Metrics::Slider_ControlThickness;
-    case PM_SliderControlThickness:
-        return Metrics::Slider_ControlThickness;
-    case PM_SliderLength:
-        return Metrics::Slider_ControlThickness;
-
-    // checkboxes and radio buttons
-    case PM_IndicatorWidth:
-        return Metrics::CheckBox_Size;
-    case PM_IndicatorHeight:
-        return Metrics::CheckBox_Size;
-    case PM_ExclusiveIndicatorWidth:
-        return Metrics::CheckBox_Size;
-    case PM_ExclusiveIndicatorHeight:
-        return Metrics::CheckBox_Size;
-
-    // list heaaders
-    case PM_HeaderMarkSize:
-        return Metrics::Header_ArrowSize;
-    case PM_HeaderMargin:
-        return Metrics::Header_MarginWidth;
-
-    // dock widget
-    // return 0 here, since frame is handled directly in polish
-    case PM_DockWidgetFrameWidth:
-        return 0;
-    case PM_DockWidgetTitleMargin:
-        return Metrics::Frame_FrameWidth;
-    case PM_DockWidgetTitleBarButtonMargin:
-        return Metrics::ToolButton_MarginWidth;
-
-    case PM_SplitterWidth:
-        return Metrics::Splitter_SplitterWidth;
-    case PM_DockWidgetSeparatorExtent:
-        return Metrics::Splitter_SplitterWidth;
-
     // fallback
     default:
         return ParentStyleClass::pixelMetric(metric, option, widget);
@@ -717,6 +912,11 @@ int Style::pixelMetric(PixelMetric metric, const QStyleOption *option, const QWi
 //______________________________________________________________
 int Style::styleHint(StyleHint hint, const QStyleOption *option, const QWidget *widget, QStyleHintReturn *returnData) const
 {
+    // constant hints
+    const int value(InspirePrivate::StyleHintTable::value(hint));
+    if (value != InspirePrivate::Unhandled)
+        return value;
+
     switch (hint) {
     case SH_RubberBand_Mask: {
         if (QStyleHintReturnMask *mask = qstyleoption_cast<QStyleHintReturnMask *>(returnData)) {
@@ -748,57 +948,6 @@ int Style::styleHint(StyleHint hint, const QStyleOption *option, const QWidget *
         return false;
     }
 
-    case SH_ComboBox_ListMouseTracking:
-        return true;
-    case SH_MenuBar_MouseTracking:
-        return true;
-    case SH_Menu_MouseTracking:
-        return true;
-    case SH_Menu_SubMenuPopupDelay:
-        return 150;
-    case SH_Menu_SloppySubMenus:
-        return true;
-
-#if QT_VERSION >= 0x050000
-    case SH_Widget_Animate:
-        return Inspire::Config::AnimationsEnabled;
-    case SH_Menu_SupportsSections:
-        return true;
-#endif
-
-    case SH_DialogButtonBox_ButtonsHaveIcons:
-        return false;
-
-    case SH_GroupBox_TextLabelVerticalAlignment:
-        return Qt::AlignVCenter;
-    case SH_TabBar_Alignment:
-        return Inspire::Config::TabBarDrawCenteredTabs ? Qt::AlignCenter : Qt::AlignLeft;
-    case SH_ToolBox_SelectedPageTitleBold:
-        return false;
-    case SH_ScrollBar_MiddleClickAbsolutePosition:
-        return true;
-    case SH_ScrollView_FrameOnlyAroundContents:
-        return false;
-    case SH_FormLayoutFormAlignment:
-        return Qt::AlignLeft | Qt::AlignTop;
-    case SH_FormLayoutLabelAlignment:
-        return Qt::AlignRight;
-    case SH_FormLayoutFieldGrowthPolicy:
-        return QFormLayout::ExpandingFieldsGrow;
-    case SH_FormLayoutWrapPolicy:
-        return QFormLayout::DontWrapRows;
-    case SH_MessageBox_TextInteractionFlags:
-        return Qt::TextSelectableByMouse | Qt::LinksAccessibleByMouse;
-    case SH_ProgressDialog_CenterCancelButton:
-        return false;
-    case SH_MessageBox_CenterButtons:
-        return false;
-    case SH_RequestSoftwareInputPanel:
-        return RSIP_OnMouseClick;
-    case SH_TitleBar_NoBorder:
-        return true;
-    case SH_DockWidget_ButtonsHaveFrame:
-        return false;
     default:
         return ParentStyleClass::styleHint(hint, option, widget, returnData);
     }
@@ -895,7 +1044,7 @@ QSize Style::sizeFromContents(ContentsType element, const QStyleOption *option,
     case CT_Slider:
         return sliderSizeFromContents(option, size, widget);
     case CT_PushButton:
-        return pushButtonSizeFromContents(option, size, widget);
+        return cachedSizeFromContents(element, option, size, widget, &Style::pushButtonSizeFromContents);
     case CT_ToolButton:
         return toolButtonSizeFromContents(option, size, widget);
     case CT_MenuBar:
@@ -903,17 +1052,17 @@ QSize Style::sizeFromContents(ContentsType element, const QStyleOption *option,
     case CT_MenuBarItem:
         return menuBarItemSizeFromContents(option, size, widget);
     case CT_MenuItem:
-        return menuItemSizeFromContents(option, size, widget);
+        return cachedSizeFromContents(element, option, size, widget, &Style::menuItemSizeFromContents);
     case CT_ProgressBar:
         return progressBarSizeFromContents(option, size, widget);
     case CT_TabWidget:
         return tabWidgetSizeFromContents(option, size, widget);
     case CT_TabBarTab:
-        return tabBarTabSizeFromContents(option, size, widget);
+        return cachedSizeFromContents(element, option, size, widget, &Style::tabBarTabSizeFromContents);
     case CT_HeaderSection:
         return headerSectionSizeFromContents(option, size, widget);
     case CT_ItemViewItem:
-        return itemViewItemSizeFromContents(option, size, widget);
+        return cachedSizeFromContents(element, option, size, widget, &Style::itemViewItemSizeFromContents);
 
     // fallback
     default:
@@ -922,6 +1071,173 @@ QSize Style::sizeFromContents(ContentsType element, const QStyleOption *option,
 
 }
 
+//______________________________________________________________
+QSize Style::cachedSizeFromContents(ContentsType element, const QStyleOption *option, const QSize &size, const QWidget *widget, StyleContentsSize function) const
+{
+    SizeCacheKey key;
+    if (!sizeCacheKey(element, option, size, widget, key))
+        return (this->*function)(option, size, widget);
+
+    // lookup cache
+    if (const QSize *cached = _sizeCache.object(key)) {
+        ++_sizeCacheStatistics.hits;
+        return *cached;
+    }
+
+    ++_sizeCacheStatistics.misses;
+    const QSize contentsSize((this->*function)(option, size, widget));
+    _sizeCache.insert(key, new QSize(contentsSize));
+    return contentsSize;
+}
+
+//______________________________________________________________
+bool Style::sizeCacheKey(ContentsType element, const QStyleOption *option, const QSize &size, const QWidget *widget, SizeCacheKey &key) const
+{
+    key.element = element;
+    key.contentsSize = size;
+
+    /*
+    text is measured with the option font metrics, which only carry a font when they are the widget's.
+    Anything else cannot be keyed and is not cached
+    */
+    auto widgetFont = [&](const QString &text) {
+        key.text = text;
+        if (text.isEmpty())
+            return true;
+        if (!(widget && option->fontMetrics == widget->fontMetrics()))
+            return false;
+        key.font = widget->font();
+        return true;
+    };
+
+    switch (element) {
+    case CT_PushButton: {
+        const QStyleOptionButton *buttonOption(qstyleoption_cast<const QStyleOptionButton *>(option));
+        if (!buttonOption)
+            return false;
+
+        key.flags = uint(buttonOption->features) | (buttonOption->icon.isNull() ? 0 : 1u << 16);
+        key.size = buttonOption->iconSize;
+        return widgetFont(buttonOption->text);
+    }
+
+    case CT_MenuItem: {
+        const QStyleOptionMenuItem *menuItemOption(qstyleoption_cast<const QStyleOptionMenuItem *>(option));
+        if (!menuItemOption)
+            return false;
+
+        key.flags = uint(menuItemOption->menuItemType) | (menuItemOption->menuHasCheckableItems ? 1u << 16 : 0);
+        key.width = menuItemOption->maxIconWidth;
+        if (menuItemOption->menuItemType != QStyleOptionMenuItem::Separator) {
+            // only the presence of an accelerator matters
+            if (menuItemOption->text.indexOf(QLatin1Char('\t')) >= 0)
+                key.flags |= 1u << 17;
+            return true;
+        }
+
+        // separator titles are measured with the item font
+        if (!menuItemOption->icon.isNull())
+            key.flags |= 1u << 18;
+        key.text = menuItemOption->text;
+        if (key.text.isEmpty())
+            return true;
+        if (!(menuItemOption->fontMetrics == QFontMetrics(menuItemOption->font)))
+            return false;
+        key.font = menuItemOption->font;
+        return true;
+    }
+
+    case CT_TabBarTab: {
+        const QStyleOptionTab *tabOption(qstyleoption_cast<const QStyleOptionTab *>(option));
+        if (!tabOption)
+            return false;
+
+        key.flags = uint(tabOption->shape) | (tabOption->icon.isNull() ? 0 : 1u << 16);
+        key.size = tabOption->leftButtonSize;
+        return widgetFont(tabOption->text);
+    }
+
+    case CT_ItemViewItem: {
+        const QStyleOptionViewItem *viewItemOption(qstyleoption_cast<const QStyleOptionViewItem *>(option));
+        if (!viewItemOption)
+            return false;
+
+        // the base class lays out text with the option font, and only reads the rect when wrapping
+        key.flags = uint(viewItemOption->features)
+                    | uint(viewItemOption->decorationPosition) << 8
+                    | uint(viewItemOption->direction) << 12
+                    | uint(viewItemOption->displayAlignment) << 16;
+        key.size = viewItemOption->decorationSize;
+        if (viewItemOption->features & QStyleOptionViewItem::WrapText)
+            key.width = viewItemOption->rect.isValid() ? viewItemOption->rect.width() : -1;
+        key.text = viewItemOption->text;
+        key.font = viewItemOption->font;
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+//______________________________________________________________
+Style::TabLayout Style::tabLabelLayout(const QStyleOptionTab *option, const QWidget *widget) const
+{
+    TabLayoutKey key;
+    const bool cached(tabLayoutKey(option, widget, key));
+    if (cached) {
+        if (const TabLayout *layout = _tabLayoutCache.object(key))
+            return *layout;
+    }
+
+    TabLayout layout;
+    QRect textRect;
+    tabLayout(option, widget, &textRect, &layout.iconRect, proxy());
+    layout.textRect = proxy()->subElementRect(SE_TabBarTabText, option, widget); // we compute the text rect twice because the style may override subElementRect
+
+    // vertical tabs are painted rotated around their rect corner
+    const QRect &rect(option->rect);
+    if (option->shape == QTabBar::RoundedEast || option->shape == QTabBar::TriangularEast) {
+        layout.transform = QTransform::fromTranslate(rect.width() + rect.x(), rect.y());
+        layout.transform.rotate(90);
+    } else if (option->shape == QTabBar::RoundedWest || option->shape == QTabBar::TriangularWest) {
+        layout.transform = QTransform::fromTranslate(rect.x(), rect.y() + rect.height());
+        layout.transform.rotate(-90);
+    }
+
+    if (cached)
+        _tabLayoutCache.insert(key, new TabLayout(layout));
+    return layout;
+}
+
+//______________________________________________________________
+bool Style::tabLayoutKey(const QStyleOptionTab *option, const QWidget *widget, TabLayoutKey &key) const
+{
+    // a proxy style may lay out tabs with other metrics
+    if (proxy() != this)
+        return false;
+
+    key.rect = option->rect;
+    key.iconSize = option->iconSize;
+    key.leftButtonSize = option->leftButtonSize;
+    key.rightButtonSize = option->rightButtonSize;
+    key.icon = option->icon.isNull() ? 0 : option->icon.cacheKey();
+
+    // selection shifts the label, enabled and selected states pick the icon size
+    key.flags = uint(option->shape)
+                | uint(option->state & (State_Selected | State_Enabled)) << 4
+                | uint(option->direction) << 24;
+
+    // same as contents sizes, text is only keyed by font when measured with the widget font metrics
+    key.text = option->text;
+    if (key.text.isEmpty())
+        return true;
+    if (!(widget && option->fontMetrics == widget->fontMetrics()))
+        return false;
+    key.font = widget->font();
+    return true;
+}
+
 //______________________________________________________________
 QStyle::SubControl Style::hitTestComplexControl(ComplexControl control, const QStyleOptionComplex *option, const QPoint &point, const QWidget *widget) const
 {
@@ -966,9 +1282,13 @@ QStyle::SubControl Style::hitTestComplexControl(ComplexControl control, const QS
 void Style::drawPrimitive(PrimitiveElement element, const QStyleOption *option, QPainter *painter, const QWidget *widget) const
 {
     StylePrimitive fcn(nullptr);
+
+    // painter state modified by the specialized function
+    PainterStateGuard::States states(PainterStateGuard::All);
     switch (element) {
     case PE_PanelButtonCommand:
         fcn = &Style::drawPanelButtonCommandPrimitive;
+        states = PainterStateGuard::Paint;
         break;
     case PE_PanelButtonTool:
         fcn = &Style::drawPanelButtonToolPrimitive;
@@ -984,15 +1304,19 @@ void Style::drawPrimitive(PrimitiveElement element, const QStyleOption *option,
         break;
     case PE_PanelItemViewRow:
         fcn = &Style::drawPanelItemViewRowPrimitive;
+        states = PainterStateGuard::Paint;
         break;
     case PE_PanelItemViewItem:
         fcn = &Style::drawPanelItemViewItemPrimitive;
+        states = PainterStateGuard::Paint | PainterStateGuard::BrushOrigin;
         break;
     case PE_IndicatorCheckBox:
         fcn = &Style::drawIndicatorCheckBoxPrimitive;
+        states = PainterStateGuard::Paint;
         break;
     case PE_IndicatorRadioButton:
         fcn = &Style::drawIndicatorRadioButtonPrimitive;
+        states = PainterStateGuard::Paint;
         break;
     case PE_IndicatorButtonDropDown:
         fcn = &Style::drawIndicatorButtonDropDownPrimitive;
@@ -1005,18 +1329,23 @@ void Style::drawPrimitive(PrimitiveElement element, const QStyleOption *option,
         break;
     case PE_IndicatorArrowUp:
         fcn = &Style::drawIndicatorArrowUpPrimitive;
+        states = PainterStateGuard::Paint;
         break;
     case PE_IndicatorArrowDown:
         fcn = &Style::drawIndicatorArrowDownPrimitive;
+        states = PainterStateGuard::Paint;
         break;
     case PE_IndicatorArrowLeft:
         fcn = &Style::drawIndicatorArrowLeftPrimitive;
+        states = PainterStateGuard::Paint;
         break;
     case PE_IndicatorArrowRight:
         fcn = &Style::drawIndicatorArrowRightPrimitive;
+        states = PainterStateGuard::Paint;
         break;
     case PE_IndicatorHeaderArrow:
         fcn = &Style::drawIndicatorHeaderArrowPrimitive;
+        states = PainterStateGuard::Paint;
         break;
     case PE_IndicatorToolBarHandle:
         fcn = &Style::drawIndicatorToolBarHandlePrimitive;
@@ -1026,15 +1355,19 @@ void Style::drawPrimitive(PrimitiveElement element, const QStyleOption *option,
         break;
     case PE_IndicatorBranch:
         fcn = &Style::drawIndicatorBranchPrimitive;
+        states = PainterStateGuard::Paint;
         break;
     case PE_FrameStatusBar:
         fcn = &Style::emptyPrimitive;
+        states = PainterStateGuard::None;
         break;
     case PE_Frame:
         fcn = &Style::drawFramePrimitive;
+        states = PainterStateGuard::Paint;
         break;
     case PE_FrameLineEdit:
         fcn = &Style::drawFrameLineEditPrimitive;
+        states = PainterStateGuard::Paint;
         break;
     case PE_FrameMenu:
         fcn = &Style::drawFrameMenuPrimitive;
@@ -1047,26 +1380,27 @@ void Style::drawPrimitive(PrimitiveElement element, const QStyleOption *option,
         break;
     case PE_FrameTabBarBase:
         fcn = &Style::drawFrameTabBarBasePrimitive;
+        states = PainterStateGuard::Paint;
         break;
     case PE_FrameWindow:
         fcn = &Style::drawFrameWindowPrimitive;
         break;
     case PE_FrameFocusRect:
         fcn = _frameFocusPrimitive;
+        states = PainterStateGuard::Paint;
         break;
     // fallback
     default:
         break;
     }
 
-    painter->save();
+    PainterStateGuard guard(painter, states);
 
     // call function if implemented
     if (!(fcn && (this->*fcn)(option, painter, widget))) {
+        guard.saveAll();
         ParentStyleClass::drawPrimitive(element, option, painter, widget);
     }
-
-    painter->restore();
 }
 
 //______________________________________________________________
@@ -1074,18 +1408,25 @@ void Style::drawControl(ControlElement element, const QStyleOption *option, QPai
 {
     StyleControl fcn(nullptr);
 
+    // painter state modified by the specialized function
+    PainterStateGuard::States states(PainterStateGuard::All);
+
         switch (element) {
         case CE_PushButtonBevel:
             fcn = &Style::drawPanelButtonCommandPrimitive;
+            states = PainterStateGuard::Paint;
             break;
         case CE_PushButtonLabel:
             fcn = &Style::drawPushButtonLabelControl;
+            states = PainterStateGuard::Paint;
             break;
         case CE_CheckBoxLabel:
             fcn = &Style::drawCheckBoxLabelControl;
+            states = PainterStateGuard::Paint;
             break;
         case CE_RadioButtonLabel:
             fcn = &Style::drawCheckBoxLabelControl;
+            states = PainterStateGuard::Paint;
             break;
         case CE_ToolButtonLabel:
             fcn = &Style::drawToolButtonLabelControl;
@@ -1113,24 +1454,30 @@ void Style::drawControl(ControlElement element, const QStyleOption *option, QPai
             break;
         case CE_ProgressBarGroove:
             fcn = &Style::drawProgressBarGrooveControl;
+            states = PainterStateGuard::Paint;
             break;
         case CE_ProgressBarLabel:
             fcn = &Style::drawProgressBarLabelControl;
             break;
         case CE_ScrollBarSlider:
             fcn = &Style::drawScrollBarSliderControl;
+            states = PainterStateGuard::Paint;
             break;
         case CE_ScrollBarAddLine:
             fcn = &Style::drawScrollBarAddLineControl;
+            states = PainterStateGuard::Paint;
             break;
         case CE_ScrollBarSubLine:
             fcn = &Style::drawScrollBarSubLineControl;
+            states = PainterStateGuard::Paint;
             break;
         case CE_ScrollBarAddPage:
             fcn = &Style::emptyControl;
+            states = PainterStateGuard::None;
             break;
         case CE_ScrollBarSubPage:
             fcn = &Style::emptyControl;
+            states = PainterStateGuard::None;
             break;
         case CE_ShapedFrame:
             fcn = &Style::drawShapedFrameControl;
@@ -1140,9 +1487,11 @@ void Style::drawControl(ControlElement element, const QStyleOption *option, QPai
             break;
         case CE_SizeGrip:
             fcn = &Style::emptyControl;
+            states = PainterStateGuard::None;
             break;
         case CE_HeaderSection:
             fcn = &Style::drawHeaderSectionControl;
+            states = PainterStateGuard::Paint;
             break;
         case CE_HeaderLabel:
             fcn = &Style::drawHeaderLabelControl;
@@ -1173,26 +1522,29 @@ void Style::drawControl(ControlElement element, const QStyleOption *option, QPai
             break;
         }
 
-    painter->save();
+    PainterStateGuard guard(painter, states);
 
     // call function if implemented
     if (!(fcn && (this->*fcn)(option, painter, widget))) {
+        guard.saveAll();
         ParentStyleClass::drawControl(element, option, painter, widget);
     }
-
-    painter->restore();
 }
 
 //______________________________________________________________
 void Style::drawComplexControl(ComplexControl element, const QStyleOptionComplex *option, QPainter *painter, const QWidget *widget) const
 {
     StyleComplexControl fcn(nullptr);
+
+    // painter state modified by the specialized function
+    PainterStateGuard::States states(PainterStateGuard::All);
     switch (element) {
     case CC_GroupBox:
         fcn = &Style::drawGroupBoxComplexControl;
         break;
     case CC_ToolButton:
         fcn = &Style::drawToolButtonComplexControl;
+        states = PainterStateGuard::Paint;
         break;
     case CC_ComboBox:
         fcn = &Style::drawComboBoxComplexControl;
@@ -1202,12 +1554,14 @@ void Style::drawComplexControl(ComplexControl element, const QStyleOptionComplex
         break;
     case CC_Slider:
         fcn = &Style::drawSliderComplexControl;
+        states = PainterStateGuard::Paint;
         break;
     case CC_Dial:
         fcn = &Style::drawDialComplexControl;
         break;
     case CC_ScrollBar:
         fcn = &Style::drawScrollBarComplexControl;
+        states = PainterStateGuard::Paint;
         break;
     case CC_TitleBar:
         fcn = &Style::drawTitleBarComplexControl;
@@ -1218,14 +1572,13 @@ void Style::drawComplexControl(ComplexControl element, const QStyleOptionComplex
         break;
     }
 
-    painter->save();
+    PainterStateGuard guard(painter, states);
 
     // call function if implemented
     if (!(fcn && (this->*fcn)(option, painter, widget))) {
+        guard.saveAll();
         ParentStyleClass::drawComplexControl(element, option, painter, widget);
     }
-
-    painter->restore();
 }
 
 //___________________________________________________________________________________
@@ -1252,36 +1605,173 @@ void Style::drawItemText(QPainter *painter, const QRect &rect, int flags, const
         const QWidget *widget(static_cast<const QWidget *>(painter->device()));
         if (_animations->widgetEnabilityEngine().isAnimated(widget, AnimationEnable)) {
             QPalette copy(_helper->disabledPalette(palette, _animations->widgetEnabilityEngine().opacity(widget, AnimationEnable)));
-            return ParentStyleClass::drawItemText(painter, rect, flags, copy, enabled, text, textRole);
+            return drawCachedItemText(painter, rect, flags, copy, enabled, text, textRole);
         }
     }
 
     // fallback
-    return ParentStyleClass::drawItemText(painter, rect, flags, palette, enabled, text, textRole);
+    return drawCachedItemText(painter, rect, flags, palette, enabled, text, textRole);
+}
+
+//_____________________________________________________________________
+void Style::drawCachedItemText(QPainter *painter, const QRect &rect, int flags, const QPalette &palette, bool enabled, const QString &text, QPalette::ColorRole textRole) const
+{
+    // disabled text may be dithered or etched by the base class
+    QTextLayout *layout(nullptr);
+    if (!text.isEmpty() && (enabled || !(proxy()->styleHint(SH_DitherDisabledText) || proxy()->styleHint(SH_EtchDisabledText))))
+        layout = itemTextLayout(painter, flags, text);
+
+    if (!layout)
+        return ParentStyleClass::drawItemText(painter, rect, flags, palette, enabled, text, textRole);
+
+    // align as QPainter::drawText does
+    const QTextLine line(layout->lineAt(0));
+    const qreal width(line.horizontalAdvance());
+    const qreal height(line.height());
+    QPointF position(rect.topLeft());
+    if (flags & Qt::AlignRight)
+        position.rx() += rect.width() - width;
+    else if (flags & Qt::AlignHCenter)
+        position.rx() += (rect.width() - width) / 2;
+
+    if (flags & Qt::AlignBottom)
+        position.ry() += rect.height() - height;
+    else if (flags & Qt::AlignVCenter)
+        position.ry() += (rect.height() - height) / 2;
+
+    // text larger than the rect is clipped, leave it to the base class
+    if (!(flags & Qt::TextDontClip) && (rect.width() < width || rect.height() < height))
+        return ParentStyleClass::drawItemText(painter, rect, flags, palette, enabled, text, textRole);
+
+    if (textRole == QPalette::NoRole) {
+        layout->draw(painter, position);
+        return;
+    }
+
+    const QPen pen(painter->pen());
+    painter->setPen(QPen(palette.brush(textRole), pen.widthF()));
+    layout->draw(painter, position);
+    painter->setPen(pen);
+}
+
+//_____________________________________________________________________
+QTextLayout *Style::itemTextLayout(QPainter *painter, int flags, const QString &text) const
+{
+    // single lines, aligned left to right
+    const int supportedFlags(int(Qt::AlignLeft | Qt::AlignRight | Qt::AlignHCenter | Qt::AlignTop | Qt::AlignBottom | Qt::AlignVCenter)
+                             | Qt::TextSingleLine | Qt::TextDontClip | Qt::TextShowMnemonic | Qt::TextHideMnemonic);
+    if ((flags & ~supportedFlags) || painter->layoutDirection() != Qt::LeftToRight)
+        return nullptr;
+
+    // leading and trailing spaces change alignment
+    if (text.at(0).isSpace() || text.at(text.size() - 1).isSpace())
+        return nullptr;
+
+    TextLayoutKey key;
+    key.text = text;
+    key.font = painter->font();
+    key.flags = flags & (Qt::TextShowMnemonic | Qt::TextHideMnemonic);
+    key.dpi = painter->device()->logicalDpiY();
+    if (QTextLayout *layout = _textLayoutCache.object(key))
+        return layout;
+
+    // process mnemonics as QPainter::drawText does, and leave line breaks, tabs and multi-length strings to it
+    const bool mnemonics(flags & (Qt::TextShowMnemonic | Qt::TextHideMnemonic));
+    const bool showMnemonic(!(flags & Qt::TextHideMnemonic));
+    QString displayText;
+    displayText.reserve(text.size());
+    QVector<QTextLayout::FormatRange> underlines;
+    for (int i = 0; i < text.size(); ++i) {
+        QChar c(text.at(i));
+        switch (c.unicode()) {
+        case '\n':
+        case '\r':
+        case '\t':
+        case 0x9c:
+        case QChar::LineSeparator:
+            return nullptr;
+
+        case '&':
+            if (!mnemonics)
+                break;
+
+            if (++i == text.size())
+                continue;
+
+            c = text.at(i);
+            if (c == QLatin1Char('&'))
+                break;
+
+            // hidden mnemonics in parentheses are removed altogether
+            if (!showMnemonic) {
+                if (i > 1 && text.at(i - 2) == QLatin1Char('('))
+                    return nullptr;
+                break;
+            }
+
+            underlines.append(QTextLayout::FormatRange());
+            underlines.last().start = displayText.size();
+            underlines.last().length = 1;
+            underlines.last().format.setFontUnderline(true);
+            break;
+
+        default:
+            break;
+        }
+
+        displayText.append(c);
+    }
+
+    QTextOption option;
+    option.setFlags(QTextOption::IncludeTrailingSpaces);
+    option.setTextDirection(Qt::LeftToRight);
+
+    QTextLayout *layout(new QTextLayout(displayText, key.font, painter->device()));
+    layout->setTextOption(option);
+    layout->setFormats(underlines);
+    layout->setCacheEnabled(true);
+
+    // a single line is placed at the top, leading only separates lines
+    layout->beginLayout();
+    QTextLine line(layout->createLine());
+    line.setLineWidth(0x01000000);
+    line.setPosition(QPointF(0, 0));
+    layout->endLayout();
+
+    if (!_textLayoutCache.insert(key, layout))
+        return nullptr;
+    return layout;
 }
 
 //_____________________________________________________________________
 bool Style::eventFilter(QObject *object, QEvent *event)
 {
-    if (QDockWidget *dockWidget = qobject_cast<QDockWidget *>(object)) {
-        return eventFilterDockWidget(dockWidget, event);
-    } else if (QMdiSubWindow *subWindow = qobject_cast<QMdiSubWindow *>(object)) {
-        return eventFilterMdiSubWindow(subWindow, event);
+    // cached widget states depend on parents
+    if (event->type() == QEvent::ParentChange)
+        widgetReparented(object);
+
+    // classes the object inherits from, cached per class
+    const WidgetKinds kinds(widgetKinds(object));
+
+    if (kinds & KindDockWidget) {
+        return eventFilterDockWidget(static_cast<QDockWidget *>(object), event);
+    } else if (kinds & KindMdiSubWindow) {
+        return eventFilterMdiSubWindow(static_cast<QMdiSubWindow *>(object), event);
     }
 #if QT_VERSION >= 0x050000
-    else if (QCommandLinkButton *commandLinkButton = qobject_cast<QCommandLinkButton *>(object)) {
-        return eventFilterCommandLinkButton(commandLinkButton, event);
+    else if (kinds & KindCommandLinkButton) {
+        return eventFilterCommandLinkButton(static_cast<QCommandLinkButton *>(object), event);
     }
 #endif
     // cast to QWidget
     QWidget *widget = static_cast<QWidget *>(object);
-    if (widget->inherits("QAbstractScrollArea") || widget->inherits("KTextEditor::View")) {
+    if (kinds & (KindAbstractScrollArea | KindTextEditorView)) {
         return eventFilterScrollArea(widget, event);
-    } else if (widget->inherits("QComboBoxPrivateContainer")) {
+    } else if (kinds & KindComboBoxContainer) {
         return eventFilterComboBoxContainer(widget, event);
     }
 
-    if ((!widget->parent() || !qobject_cast<QWidget *>(widget->parent()) || qobject_cast<QDialog *>(widget) || qobject_cast<QMainWindow *>(widget))
+    if ((!widget->parent() || !widget->parent()->isWidgetType() || (kinds & (KindDialog | KindMainWindow)))
         && (QEvent::Show == event->type() || QEvent::StyleChange == event->type())) {
         _helper->setVariant(widget, "light");
     }
@@ -1356,7 +1846,7 @@ bool Style::eventFilterScrollArea(QWidget *widget, QEvent *event)
                 scrollBars.append(scrollArea->horizontalScrollBar());
             if (scrollArea->verticalScrollBarPolicy() != Qt::ScrollBarAlwaysOff)
                 scrollBars.append(scrollArea->verticalScrollBar());
-        } else if (widget->inherits("KTextEditor::View")) {
+        } else if (widgetKinds(widget) & KindTextEditorView) {
             scrollBars = widget->findChildren<QScrollBar *>();
         }
 
@@ -1569,6 +2059,26 @@ void Style::configurationChanged(void)
     loadConfiguration();
 }
 
+//_____________________________________________________________________
+void Style::clearSizeCache(void)
+{
+    _sizeCache.clear();
+}
+
+//_____________________________________________________________________
+void Style::kdeConfigChanged(const KConfigGroup &group, const QByteArrayList &names)
+{
+    if (group.name() != QLatin1String("KDE"))
+        return;
+
+    if (names.contains("ShowIconsInMenuItems") || names.contains("ShowIconsOnPushButtons")) {
+        loadIconSettings();
+
+        // push button sizes depend on icon visibility
+        clearSizeCache();
+    }
+}
+
 //____________________________________________________________________
 QIcon Style::standardIconImplementation(StandardPixmap standardPixmap, const QStyleOption *option, const QWidget *widget) const
 {
@@ -1613,6 +2123,9 @@ void Style::loadConfiguration()
 {
     // load the palette
     _helper->loadConfig();
+
+    // offscreen rendering backend for transitions
+    TransitionWidget::setImageBackend(_helper->imageBackend());
     
     // reinitialize engines
     _animations->setupEngines();
@@ -1627,6 +2140,20 @@ void Style::loadConfiguration()
     // clear icon cache
     _iconCache.clear();
 
+    // icon settings
+    loadIconSettings();
+
+    // contents sizes depend on configuration
+    _sizeCache.setMaxCost(Inspire::Config::SizeCacheSize);
+    clearSizeCache();
+
+    // so do tab label layouts
+    _tabLayoutCache.setMaxCost(Inspire::Config::TabLayoutCacheSize);
+    _tabLayoutCache.clear();
+
+    _textLayoutCache.setMaxCost(Inspire::Config::TextLayoutCacheSize);
+    _textLayoutCache.clear();
+
     // scrollbar buttons
     switch (Inspire::Config::ScrollBarAddLineButtons) {
     case 0:
@@ -3855,23 +4382,19 @@ bool Style::drawPanelItemViewRowPrimitive(const QStyleOption *option, QPainter *
 }
 
 //___________________________________________________________________________________
-bool Style::drawPanelItemViewItemPrimitive(const QStyleOption *option, QPainter *painter, const QWidget *widget) const
+bool Style::drawPanelItemViewItemPrimitive(const QStyleOption *option, QPainter *painter, const QWidget *) const
 {
     // cast option and check
     const QStyleOptionViewItemV4 *viewItemOption = qstyleoption_cast<const QStyleOptionViewItemV4 *>(option);
     if (!viewItemOption)
         return false;
 
-    // try cast widget
-    const QAbstractItemView *abstractItemView = qobject_cast<const QAbstractItemView *>(widget);
-
     // store palette and rect
     const QPalette &palette(option->palette);
     QRect rect(option->rect);
 
     // store flags
     const State &state(option->state);
-    bool mouseOver((state & State_Active) && (state & State_MouseOver) && (!abstractItemView || abstractItemView->selectionMode() != QAbstractItemView::NoSelection));
     bool selected(state & State_Selected);
     bool enabled(state & State_Enabled);
     bool windowActive(state & State_Active);
@@ -3941,7 +4464,7 @@ bool Style::drawIndicatorCheckBoxPrimitive(const QStyleOption *option, QPainter
     const QColor &background(_helper->indicatorBackgroundColor(palette, mouseOver, false, sunken, AnimationData::OpacityInvalid, AnimationNone, checkBoxState));
 
     // detect checkboxes in lists
-    bool isSelectedItem(this->isSelectedItem(widget, rect.center()));
+    bool isSelectedItem(this->isSelectedItem(option, widget, rect.center()));
 
     // animation state
     _animations->widgetStateEngine().updateState(widget, AnimationHover, mouseOver);
@@ -3990,7 +4513,7 @@ bool Style::drawIndicatorRadioButtonPrimitive(const QStyleOption *option, QPaint
     RadioButtonState radioButtonState(state & State_On ? RadioOn : RadioOff);
 
     // detect radiobuttons in lists
-    bool isSelectedItem(this->isSelectedItem(widget, rect.center()));
+    bool isSelectedItem(this->isSelectedItem(option, widget, rect.center()));
 
     // animation state
     _animations->widgetStateEngine().updateState(widget, AnimationHover, mouseOver);
@@ -5502,35 +6025,20 @@ bool Style::drawTabBarTabLabelControl(const QStyleOption *option, QPainter *pain
 {
     if (const QStyleOptionTab *tab = qstyleoption_cast<const QStyleOptionTab *>(option)) {
         QStyleOptionTabV3 tabV2(*tab);
-        QRect tr = tabV2.rect;
-        bool verticalTabs = tabV2.shape == QTabBar::RoundedEast
-                            || tabV2.shape == QTabBar::RoundedWest
-                            || tabV2.shape == QTabBar::TriangularEast
-                            || tabV2.shape == QTabBar::TriangularWest;
+        bool verticalTabs = isVerticalTab(tab);
 
         int alignment = Qt::AlignCenter | Qt::TextShowMnemonic;
         if (!proxy()->styleHint(SH_UnderlineShortcut, option, widget))
             alignment |= Qt::TextHideMnemonic;
 
+        // icon and text rects, only laid out again when the tab changes
+        const TabLayout layout(tabLabelLayout(tab, widget));
         if (verticalTabs) {
             painter->save();
-            int newX, newY, newRot;
-            if (tabV2.shape == QTabBar::RoundedEast || tabV2.shape == QTabBar::TriangularEast) {
-                newX = tr.width() + tr.x();
-                newY = tr.y();
-                newRot = 90;
-            } else {
-                newX = tr.x();
-                newY = tr.y() + tr.height();
-                newRot = -90;
-            }
-            QTransform m = QTransform::fromTranslate(newX, newY);
-            m.rotate(newRot);
-            painter->setTransform(m, true);
+            painter->setTransform(layout.transform, true);
         }
-        QRect iconRect;
-        tabLayout(&tabV2, widget, &tr, &iconRect, proxy());
-        tr = proxy()->subElementRect(SE_TabBarTabText, option, widget); //we compute tr twice because the style may override subElementRect
+        const QRect &iconRect(layout.iconRect);
+        const QRect &tr(layout.textRect);
 
         if (!tabV2.icon.isNull()) {
             QPixmap tabIcon = tabV2.icon.pixmap(tabV2.iconSize, (tabV2.state & State_Enabled) ? QIcon::Normal : QIcon::Disabled,
@@ -5574,9 +6082,8 @@ bool Style::drawTabBarTabLabelControl(const QStyleOption *option, QPainter *pain
         }
     }
 
-    // store rect and palette
+    // store rect
     const QRect &rect(option->rect);
-    const QPalette &palette(option->palette);
 
     // check focus
     const State &state(option->state);
@@ -5584,52 +6091,8 @@ bool Style::drawTabBarTabLabelControl(const QStyleOption *option, QPainter *pain
     bool selected(state & State_Selected);
     bool hasFocus(enabled && selected && (state & State_HasFocus));
 
-    // update mouse over animation state
+    // update focus animation state. The focus itself is rendered by the frame above
     _animations->tabBarEngine().updateState(widget, rect.topLeft(), AnimationFocus, hasFocus);
-    bool animated(enabled && selected && _animations->tabBarEngine().isAnimated(widget, rect.topLeft(), AnimationFocus));
-    qreal opacity(_animations->tabBarEngine().opacity(widget, rect.topLeft(), AnimationFocus));
-
-    if (!(hasFocus || animated))
-        return true;
-
-    // code is copied from QCommonStyle, but adds focus
-    // cast option and check
-    const QStyleOptionTab *tabOption(qstyleoption_cast<const QStyleOptionTab *>(option));
-    if (!tabOption || tabOption->text.isEmpty())
-        return true;
-
-    // tab option rect
-    bool verticalTabs(isVerticalTab(tabOption));
-    int textFlags(Qt::AlignCenter | _mnemonics->textFlags());
-
-    // text rect
-    QRect textRect(subElementRect(SE_TabBarTabText, option, widget));
-
-    if (verticalTabs) {
-        // properly rotate painter
-        painter->save();
-        int newX, newY, newRot;
-        if (tabOption->shape == QTabBar::RoundedEast || tabOption->shape == QTabBar::TriangularEast) {
-            newX = rect.width() + rect.x();
-            newY = rect.y();
-            newRot = 90;
-        } else {
-            newX = rect.x();
-            newY = rect.y() + rect.height();
-            newRot = -90;
-        }
-
-        QTransform transform;
-        transform.translate(newX, newY);
-        transform.rotate(newRot);
-        painter->setTransform(transform, true);
-    }
-
-    // adjust text rect based on font metrics
-    textRect = option->fontMetrics.boundingRect(textRect, textFlags, tabOption->text);
-
-    if (verticalTabs)
-        painter->restore();
 
     return true;
 }
@@ -6044,8 +6507,8 @@ bool Style::drawToolButtonComplexControl(const QStyleOptionComplex *option, QPai
         if (inTabBar) {
             QRect rect(option->rect);
             QColor background(_helper->mix(option->palette.window().color(), option->palette.shadow().color(), 0.15));
-            background = _helper->mix(background, Qt::white, 0.2 * mouseOpacity);
-            background = _helper->mix(background, Qt::black, 0.15 * pressedOpacity);
+            background = Helper::interpolate(background, Qt::white, 0.2 * mouseOpacity);
+            background = Helper::interpolate(background, Qt::black, 0.15 * pressedOpacity);
             QColor outline(_helper->frameOutlineColor(option->palette));
             painter->setPen(background);
             painter->setBrush(background);
@@ -6599,20 +7062,19 @@ bool Style::drawScrollBarComplexControl(const QStyleOptionComplex *option, QPain
         if (enabled) {
             painter->setPen(Qt::NoPen);
             painter->setBrush(color);
-            painter->drawRect(option->rect);
-            
-            painter->setPen(_helper->menuOutlineColor(palette));
+            _helper->fillRect(painter, option->rect, color);
+
+            QColor outline(_helper->menuOutlineColor(palette));
             //Separator lines akin to the GTK3 theme 'cos contrast
             if (horizontal) {
-                painter->drawLine(option->rect.topLeft(), option->rect.topRight());
+                _helper->drawLine(painter, option->rect.topLeft(), option->rect.topRight(), outline);
             } else {
                 if (option->direction == Qt::RightToLeft) {
-                    painter->drawLine(option->rect.topRight(), option->rect.bottomRight());
+                    _helper->drawLine(painter, option->rect.topRight(), option->rect.bottomRight(), outline);
                 } else {
-                    painter->drawLine(option->rect.topLeft(), option->rect.bottomLeft());
+                    _helper->drawLine(painter, option->rect.topLeft(), option->rect.bottomLeft(), outline);
                 }
             }
-            painter->setPen(Qt::NoPen);
         }
     }
 
@@ -6939,7 +7401,7 @@ QColor Style::scrollBarArrowColor(const QStyleOptionSlider *option, const SubCon
     if (rect.intersects(_animations->scrollBarEngine().subControlRect(widget, control))) {
         QColor highlight = _helper->hoverColor(palette);
         if (animated) {
-            color = Helper::mix(color, highlight, opacity);
+            color = Helper::interpolate(color, highlight, opacity);
         } else if (mouseOver) {
             color = highlight;
         }
@@ -7168,13 +7630,19 @@ const QAbstractItemView *Style::itemViewParent(const QWidget *widget) const
 }
 
 //____________________________________________________________________
-bool Style::isSelectedItem(const QWidget *widget, const QPoint &localPosition) const
+bool Style::isSelectedItem(const QStyleOption *option, const QWidget *widget, const QPoint &localPosition) const
 {
     // get relevant itemview parent and check
     const QAbstractItemView *itemView(itemViewParent(widget));
     if (!(itemView && itemView->hasFocus() && itemView->selectionModel()))
         return false;
 
+    // indicators painted by the view delegate carry their index
+    if (const QStyleOptionViewItem *viewItemOption = qstyleoption_cast<const QStyleOptionViewItem *>(option)) {
+        if (viewItemOption->index.isValid() && viewItemOption->index.model() == itemView->model())
+            return itemView->selectionModel()->isSelected(viewItemOption->index);
+    }
+
 #if QT_VERSION >= 0x050000
     QPoint position = widget->mapTo(itemView, localPosition);
 #else
@@ -7182,13 +7650,8 @@ bool Style::isSelectedItem(const QWidget *widget, const QPoint &localPosition) c
     QPoint position = widget->mapTo(const_cast<QAbstractItemView *>(itemView), localPosition);
 #endif
 
-    // get matching QModelIndex and check
-    QModelIndex index(itemView->indexAt(position));
-    if (!index.isValid())
-        return false;
-
-    // check whether index is selected
-    return itemView->selectionModel()->isSelected(index);
+    // check whether matching index is selected
+    return _selectionData->isSelected(itemView, widget, position);
 }
 
 //____________________________________________________________________
@@ -7204,17 +7667,44 @@ bool Style::isQtQuickControl(const QStyleOption *option, const QWidget *widget)
 }
 
 //____________________________________________________________________
-bool Style::showIconsInMenuItems(void) const
+void Style::loadIconSettings(void)
 {
     const KConfigGroup g(KSharedConfig::openConfig(), "KDE");
-    return g.readEntry("ShowIconsInMenuItems", true);
+    _showIconsInMenuItems = g.readEntry("ShowIconsInMenuItems", Settings::ShowIconsInMenuItems);
+    _showIconsOnPushButtons = g.readEntry("ShowIconsOnPushButtons", Settings::ShowIconsOnPushButtons);
 }
 
 //____________________________________________________________________
-bool Style::showIconsOnPushButtons(void) const
+Style::WidgetState &Style::widgetState(const QWidget *widget) const
 {
-    const KConfigGroup g(KSharedConfig::openConfig(), "KDE");
-    return g.readEntry("ShowIconsOnPushButtons", true);
+    auto iter(_widgetStates.find(widget));
+    if (iter != _widgetStates.end())
+        return iter.value();
+
+    // states are dropped when the widget is destroyed or reparented
+    connect(widget, &QObject::destroyed, this, &Style::widgetDestroyed, Qt::UniqueConnection);
+    const_cast<Style *>(this)->addEventFilter(const_cast<QWidget *>(widget));
+    return _widgetStates[widget];
+}
+
+//____________________________________________________________________
+void Style::widgetReparented(QObject *object)
+{
+    /*
+     * children only inherit an altered background through parents that have a cached state,
+     * so there is nothing more to drop when the widget has none
+     */
+    if (!_widgetStates.remove(object))
+        return;
+
+    foreach (auto child, static_cast<QWidget *>(object)->findChildren<QWidget *>())
+        _widgetStates.remove(child);
+}
+
+//____________________________________________________________________
+void Style::widgetDestroyed(QObject *object)
+{
+    _widgetStates.remove(object);
 }
 
 //____________________________________________________________________
@@ -7224,10 +7714,12 @@ bool Style::isMenuTitle(const QWidget *widget) const
     if (!widget)
         return false;
 
-    // check property
-    QVariant property(widget->property(PropertyNames::menuTitle));
-    if (property.isValid())
-        return property.toBool();
+    // check cache
+    WidgetState &state(widgetState(widget));
+    if (state.flags & MenuTitleChecked)
+        return state.flags & MenuTitle;
+
+    state.flags |= MenuTitleChecked;
 
     // detect menu toolbuttons
     QWidget *parent = widget->parentWidget();
@@ -7235,12 +7727,11 @@ bool Style::isMenuTitle(const QWidget *widget) const
         foreach (auto child, parent->findChildren<QWidgetAction *>()) {
             if (child->defaultWidget() != widget)
                 continue;
-            const_cast<QWidget *>(widget)->setProperty(PropertyNames::menuTitle, true);
+            state.flags |= MenuTitle;
             return true;
         }
     }
 
-    const_cast<QWidget *>(widget)->setProperty(PropertyNames::menuTitle, false);
     return false;
 }
 
@@ -7251,10 +7742,10 @@ bool Style::hasAlteredBackground(const QWidget *widget) const
     if (!widget)
         return false;
 
-    // check property
-    QVariant property(widget->property(PropertyNames::alteredBackground));
-    if (property.isValid())
-        return property.toBool();
+    // check cache
+    const WidgetState &state(widgetState(widget));
+    if (state.flags & AlteredBackgroundChecked)
+        return state.flags & AlteredBackground;
 
     // check if widget is of relevant type
     bool hasAlteredBackground(false);
@@ -7269,7 +7760,9 @@ bool Style::hasAlteredBackground(const QWidget *widget) const
 
     if (widget->parentWidget() && !hasAlteredBackground)
         hasAlteredBackground = this->hasAlteredBackground(widget->parentWidget());
-    const_cast<QWidget *>(widget)->setProperty(PropertyNames::alteredBackground, hasAlteredBackground);
+
+    // lookup again, parents may have been inserted in the meantime
+    widgetState(widget).flags |= AlteredBackgroundChecked | (hasAlteredBackground ? AlteredBackground : 0);
     return hasAlteredBackground;
 }
 
@@ -29,15 +29,20 @@
 #include <KStyle>
 #endif
 
+#include <KConfigWatcher>
+
 #include <QAbstractItemView>
 #include <QAbstractScrollArea>
 
+#include <QCache>
 #include <QCommonStyle>
 #include <QDockWidget>
 #include <QHash>
 #include <QIcon>
 #include <QMdiSubWindow>
 #include <QStyleOption>
+#include <QTextLayout>
+#include <QTransform>
 #include <QWidget>
 
 #if QT_VERSION >= 0x050000
@@ -47,6 +52,7 @@
 namespace InspirePrivate
 {
 class TabBarData;
+class SelectionData;
 }
 
 namespace Inspire
@@ -110,6 +116,24 @@ public:
     //* returns size matching contents
     QSize sizeFromContents(ContentsType element, const QStyleOption *option, const QSize &size, const QWidget *widget) const;
 
+    //* cache hit and miss counters
+    struct CacheStatistics {
+        quint64 hits = 0;
+        quint64 misses = 0;
+    };
+
+    //* contents size cache statistics
+    const CacheStatistics &sizeCacheStatistics() const
+    {
+        return _sizeCacheStatistics;
+    }
+
+    //* helper, whose cache statistics cover the primitives painted by the style
+    const Helper &helper() const
+    {
+        return *_helper;
+    }
+
     //* returns which subcontrol given QPoint corresponds to
     SubControl hitTestComplexControl(ComplexControl control, const QStyleOptionComplex *option , const QPoint &point, const QWidget *widget) const;
 
@@ -153,6 +177,15 @@ protected Q_SLOTS:
     //* update configuration
     void configurationChanged(void);
 
+    //* drop memoized contents sizes
+    void clearSizeCache(void);
+
+    //* drop cached state of destroyed widget
+    void widgetDestroyed(QObject *object);
+
+    //* reload KDE settings when changed from outside the application
+    void kdeConfigChanged(const KConfigGroup &group, const QByteArrayList &names);
+
     //* standard icons
     virtual QIcon standardIconImplementation(StandardPixmap standardPixmap, const QStyleOption *option, const QWidget *widget) const;
 
@@ -235,6 +268,12 @@ protected:
     QSize headerSectionSizeFromContents(const QStyleOption *option, const QSize &size, const QWidget *widget) const;
     QSize itemViewItemSizeFromContents(const QStyleOption *option, const QSize &size, const QWidget *widget) const;
 
+    //* pointer to sizeFromContents specialized function
+    using StyleContentsSize = QSize (Style::*)(const QStyleOption *option, const QSize &size, const QWidget *widget) const;
+
+    //* memoized call to sizeFromContents specialized function, for contents that only depend on the option
+    QSize cachedSizeFromContents(ContentsType element, const QStyleOption *option, const QSize &size, const QWidget *widget, StyleContentsSize function) const;
+
     //@}
 
     //*@name primitives specialized functions
@@ -410,10 +449,11 @@ protected:
     //* returns true if a given widget is a selected item in a focused list
     /**
     This is necessary to have the correct colors used for e.g. checkboxes and radiobuttons in lists
+    @param option The painted option, whose index is used when painted by the view delegate
     @param widget The widget to be checked
-    @param position Used to find the relevant QModelIndex
+    @param position Used to find the relevant QModelIndex otherwise
     */
-    bool isSelectedItem(const QWidget *widget, const QPoint &localPosition) const;
+    bool isSelectedItem(const QStyleOption *option, const QWidget *widget, const QPoint &localPosition) const;
 
     //* return true if option corresponds to QtQuick control
     bool isQtQuickControl(const QStyleOption *option, const QWidget *widget) const;
@@ -494,10 +534,19 @@ protected:
     template<typename T> bool hasParent(const QWidget *widget) const;
 
     //* return true if icons should be shown in menus
-    bool showIconsInMenuItems(void) const;
+    bool showIconsInMenuItems(void) const
+    {
+        return _showIconsInMenuItems;
+    }
 
     //* return true if icons should be shown on buttons
-    bool showIconsOnPushButtons(void) const;
+    bool showIconsOnPushButtons(void) const
+    {
+        return _showIconsOnPushButtons;
+    }
+
+    //* read icon settings from the KDE configuration
+    void loadIconSettings(void);
 
     //* return true if passed widget is a menu title (KMenu::addTitle)
     bool isMenuTitle(const QWidget *widget) const;
@@ -507,6 +556,31 @@ protected:
 
 private:
 
+    //*@name widget state cache, for isMenuTitle and hasAlteredBackground
+    //@{
+
+    enum WidgetStateFlag {
+        MenuTitleChecked = 0x1,
+        MenuTitle = 0x2,
+        AlteredBackgroundChecked = 0x4,
+        AlteredBackground = 0x8
+    };
+
+    struct WidgetState {
+        int flags = 0;
+    };
+
+    //* cached state for widget, created if needed. The style filters events of the widget, to follow reparenting
+    WidgetState &widgetState(const QWidget *widget) const;
+
+    //* drop cached states of reparented widget and its children, which were computed from its former parents
+    void widgetReparented(QObject *object);
+
+    //* widget state cache
+    mutable QHash<const QObject *, WidgetState> _widgetStates;
+
+    //@}
+
     //*@name scrollbar button types (for addLine and subLine )
     //@{
     ScrollBarButtonType _addLineButtons;
@@ -537,10 +611,174 @@ private:
     //* tabbar data
     InspirePrivate::TabBarData *_tabBarData;
 
+    //* selection state of widgets embedded in item views
+    InspirePrivate::SelectionData *_selectionData;
+
     //* icon hash
     using IconCache = QHash<StandardPixmap, QIcon>;
     IconCache _iconCache;
 
+    //* contents size cache key
+    struct SizeCacheKey {
+        bool operator==(const SizeCacheKey &other) const
+        {
+            return element == other.element
+                   && contentsSize == other.contentsSize
+                   && size == other.size
+                   && flags == other.flags
+                   && width == other.width
+                   && text == other.text
+                   && font == other.font;
+        }
+
+        friend uint qHash(const SizeCacheKey &key, uint seed = 0)
+        {
+            uint hash(seed ^ uint(key.element));
+            auto combine = [&hash](uint value) {
+                hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            };
+
+            combine(uint(key.contentsSize.width()));
+            combine(uint(key.contentsSize.height()));
+            combine(uint(key.size.width()));
+            combine(uint(key.size.height()));
+            combine(key.flags);
+            combine(uint(key.width));
+            combine(qHash(key.text));
+            return hash;
+        }
+
+        ContentsType element = CT_CustomBase;
+        QSize contentsSize;
+
+        //* icon, decoration or tab button size
+        QSize size;
+
+        //* option features and type
+        uint flags = 0;
+
+        //* icon width for menu items, available width for wrapped item view text
+        int width = 0;
+
+        QString text;
+        QFont font;
+    };
+
+    //* fill contents size cache key from option. Returns false if the contents size cannot be cached
+    bool sizeCacheKey(ContentsType element, const QStyleOption *option, const QSize &size, const QWidget *widget, SizeCacheKey &key) const;
+
+    //* contents size cache
+    mutable QCache<SizeCacheKey, QSize> _sizeCache;
+
+    //* contents size cache statistics
+    mutable CacheStatistics _sizeCacheStatistics;
+
+    //*@name tab label layout cache
+    //@{
+
+    //* icon and text rects, and painter transform for vertical tabs
+    struct TabLayout {
+        QRect iconRect;
+        QRect textRect;
+        QTransform transform;
+    };
+
+    //* tab label layout cache key
+    struct TabLayoutKey {
+        bool operator==(const TabLayoutKey &other) const
+        {
+            return rect == other.rect
+                   && iconSize == other.iconSize
+                   && leftButtonSize == other.leftButtonSize
+                   && rightButtonSize == other.rightButtonSize
+                   && icon == other.icon
+                   && flags == other.flags
+                   && text == other.text
+                   && font == other.font;
+        }
+
+        friend uint qHash(const TabLayoutKey &key, uint seed = 0)
+        {
+            uint hash(seed ^ key.flags);
+            auto combine = [&hash](uint value) {
+                hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            };
+
+            combine(uint(key.rect.x()));
+            combine(uint(key.rect.y()));
+            combine(uint(key.rect.width()));
+            combine(uint(key.rect.height()));
+            combine(uint(key.iconSize.width()));
+            combine(qHash(key.icon));
+            combine(qHash(key.text));
+            return hash;
+        }
+
+        QRect rect;
+        QSize iconSize;
+        QSize leftButtonSize;
+        QSize rightButtonSize;
+
+        //* icon cache key, zero for no icon
+        qint64 icon = 0;
+
+        //* shape, state and direction
+        uint flags = 0;
+
+        QString text;
+        QFont font;
+    };
+
+    //* label layout of a tab, cached unless it cannot be keyed
+    TabLayout tabLabelLayout(const QStyleOptionTab *option, const QWidget *widget) const;
+
+    //* fill tab label layout cache key from option. Returns false if the layout cannot be cached
+    bool tabLayoutKey(const QStyleOptionTab *option, const QWidget *widget, TabLayoutKey &key) const;
+
+    //* tab label layout cache
+    mutable QCache<TabLayoutKey, TabLayout> _tabLayoutCache;
+
+    //@}
+
+    //*@name item text layout cache
+    //@{
+
+    //* item text layout cache key
+    struct TextLayoutKey {
+        bool operator==(const TextLayoutKey &other) const
+        {
+            return flags == other.flags
+                   && dpi == other.dpi
+                   && text == other.text
+                   && font == other.font;
+        }
+
+        friend uint qHash(const TextLayoutKey &key, uint seed = 0)
+        {
+            return qHash(key.text, seed) ^ key.flags ^ (uint(key.dpi) << 8);
+        }
+
+        QString text;
+        QFont font;
+
+        //* mnemonic visibility
+        int flags = 0;
+
+        //* paint device resolution the font is resolved for
+        int dpi = 0;
+    };
+
+    //* draw item text from a cached layout, when QPainter::drawText would lay it out the same way
+    void drawCachedItemText(QPainter *painter, const QRect &rect, int flags, const QPalette &palette, bool enabled, const QString &text, QPalette::ColorRole textRole) const;
+
+    //* single line layout of text, as QPainter::drawText would lay it out. Returns nullptr if the text cannot be laid out here
+    QTextLayout *itemTextLayout(QPainter *painter, int flags, const QString &text) const;
+
+    //* item text layout cache
+    mutable QCache<TextLayoutKey, QTextLayout> _textLayoutCache;
+
+    //@}
+
     //* pointer to primitive specialized function
     using StylePrimitive = bool(Style::*)(const QStyleOption *option, QPainter *painter, const QWidget *widget) const;
     StylePrimitive _frameFocusPrimitive = nullptr;
@@ -563,6 +801,17 @@ private:
     bool _isGNOME { false };
     bool _isKDE { false };
 
+    //*@name KDE icon settings, read once and refreshed on configuration change
+    //@{
+
+    bool _showIconsInMenuItems { Settings::ShowIconsInMenuItems };
+    bool _showIconsOnPushButtons { Settings::ShowIconsOnPushButtons };
+
+    //* notifies changes to the KDE configuration
+    KConfigWatcher::Ptr _configWatcher;
+
+    //@}
+
     //@}
 };
 
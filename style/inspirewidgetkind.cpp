@@ -0,0 +1,140 @@
+/*************************************************************************
+ * Copyright (C) 2026 Inspire contributors                               *
+ *                                                                       *
+ * This program is free software; you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation; either version 2 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program; if not, write to the                         *
+ * Free Software Foundation, Inc.,                                       *
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA .        *
+ *************************************************************************/
+
+#include "inspirewidgetkind.h"
+
+#include <QAbstractItemView>
+#include <QAbstractScrollArea>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QCommandLinkButton>
+#include <QDial>
+#include <QDialog>
+#include <QDockWidget>
+#include <QGroupBox>
+#include <QHash>
+#include <QHeaderView>
+#include <QLineEdit>
+#include <QMainWindow>
+#include <QMdiSubWindow>
+#include <QMenu>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QRadioButton>
+#include <QScrollBar>
+#include <QSlider>
+#include <QSpinBox>
+#include <QSplitterHandle>
+#include <QStackedWidget>
+#include <QTabBar>
+#include <QTextEdit>
+#include <QToolBox>
+#include <QToolButton>
+
+namespace Inspire
+{
+
+//____________________________________________________________________
+static WidgetKinds classify(const QMetaObject *metaObject)
+{
+    struct MetaObjectKind {
+        const QMetaObject *metaObject;
+        WidgetKind kind;
+    };
+
+    static const MetaObjectKind metaObjectKinds[] = {
+        {&QAbstractButton::staticMetaObject, KindAbstractButton},
+        {&QToolButton::staticMetaObject, KindToolButton},
+        {&QPushButton::staticMetaObject, KindPushButton},
+        {&QCheckBox::staticMetaObject, KindCheckBox},
+        {&QRadioButton::staticMetaObject, KindRadioButton},
+        {&QCommandLinkButton::staticMetaObject, KindCommandLinkButton},
+        {&QGroupBox::staticMetaObject, KindGroupBox},
+        {&QScrollBar::staticMetaObject, KindScrollBar},
+        {&QSlider::staticMetaObject, KindSlider},
+        {&QDial::staticMetaObject, KindDial},
+        {&QProgressBar::staticMetaObject, KindProgressBar},
+        {&QComboBox::staticMetaObject, KindComboBox},
+        {&QAbstractSpinBox::staticMetaObject, KindAbstractSpinBox},
+        {&QSpinBox::staticMetaObject, KindSpinBox},
+        {&QLineEdit::staticMetaObject, KindLineEdit},
+        {&QTextEdit::staticMetaObject, KindTextEdit},
+        {&QHeaderView::staticMetaObject, KindHeaderView},
+        {&QAbstractItemView::staticMetaObject, KindAbstractItemView},
+        {&QTabBar::staticMetaObject, KindTabBar},
+        {&QAbstractScrollArea::staticMetaObject, KindAbstractScrollArea},
+        {&QStackedWidget::staticMetaObject, KindStackedWidget},
+        {&QSplitterHandle::staticMetaObject, KindSplitterHandle},
+        {&QFrame::staticMetaObject, KindFrame},
+        {&QDockWidget::staticMetaObject, KindDockWidget},
+        {&QMdiSubWindow::staticMetaObject, KindMdiSubWindow},
+        {&QToolBox::staticMetaObject, KindToolBox},
+        {&QMenu::staticMetaObject, KindMenu},
+        {&QDialog::staticMetaObject, KindDialog},
+        {&QMainWindow::staticMetaObject, KindMainWindow}
+    };
+
+    // private or external classes, only known by name
+    struct ClassNameKind {
+        const char *className;
+        WidgetKind kind;
+    };
+
+    static const ClassNameKind classNameKinds[] = {
+        {"KTextEditor::View", KindTextEditorView},
+        {"QComboBoxPrivateContainer", KindComboBoxContainer},
+        {"QTipLabel", KindTipLabel}
+    };
+
+    WidgetKinds kinds(KindNone);
+    for (; metaObject; metaObject = metaObject->superClass()) {
+        for (const MetaObjectKind &entry : metaObjectKinds) {
+            if (entry.metaObject == metaObject)
+                kinds |= entry.kind;
+        }
+
+        for (const ClassNameKind &entry : classNameKinds) {
+            if (qstrcmp(entry.className, metaObject->className()) == 0)
+                kinds |= entry.kind;
+        }
+    }
+
+    return kinds;
+}
+
+//____________________________________________________________________
+WidgetKinds widgetKinds(const QObject *object)
+{
+    if (!object)
+        return KindNone;
+
+    // widgets are only polished and filtered from the gui thread
+    static QHash<const QMetaObject *, WidgetKinds> cache;
+
+    const QMetaObject *metaObject(object->metaObject());
+    auto iter(cache.constFind(metaObject));
+    if (iter != cache.constEnd())
+        return iter.value();
+
+    const WidgetKinds kinds(classify(metaObject));
+    cache.insert(metaObject, kinds);
+    return kinds;
+}
+
+}
@@ -0,0 +1,79 @@
+#ifndef inspirewidgetkind_h
+#define inspirewidgetkind_h
+
+/*************************************************************************
+ * Copyright (C) 2026 Inspire contributors                               *
+ *                                                                       *
+ * This program is free software; you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation; either version 2 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program; if not, write to the                         *
+ * Free Software Foundation, Inc.,                                       *
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA .        *
+ *************************************************************************/
+
+#include <QFlags>
+#include <QObject>
+
+namespace Inspire
+{
+
+//* widget classes polishing, animations and event filtering dispatch on
+/** a widget has the kind of every class it inherits from */
+enum WidgetKind : uint {
+    KindNone = 0,
+    KindAbstractButton = 1u << 0,
+    KindToolButton = 1u << 1,
+    KindPushButton = 1u << 2,
+    KindCheckBox = 1u << 3,
+    KindRadioButton = 1u << 4,
+    KindCommandLinkButton = 1u << 5,
+    KindGroupBox = 1u << 6,
+    KindScrollBar = 1u << 7,
+    KindSlider = 1u << 8,
+    KindDial = 1u << 9,
+    KindProgressBar = 1u << 10,
+    KindComboBox = 1u << 11,
+    KindAbstractSpinBox = 1u << 12,
+    KindSpinBox = 1u << 13,
+    KindLineEdit = 1u << 14,
+    KindTextEdit = 1u << 15,
+    KindTextEditorView = 1u << 16,
+    KindHeaderView = 1u << 17,
+    KindAbstractItemView = 1u << 18,
+    KindTabBar = 1u << 19,
+    KindAbstractScrollArea = 1u << 20,
+    KindStackedWidget = 1u << 21,
+    KindSplitterHandle = 1u << 22,
+    KindFrame = 1u << 23,
+    KindDockWidget = 1u << 24,
+    KindMdiSubWindow = 1u << 25,
+    KindToolBox = 1u << 26,
+    KindMenu = 1u << 27,
+    KindComboBoxContainer = 1u << 28,
+    KindTipLabel = 1u << 29,
+    KindDialog = 1u << 30,
+    KindMainWindow = 1u << 31
+};
+Q_DECLARE_FLAGS(WidgetKinds, WidgetKind)
+
+//* kinds of the object's class
+/**
+classification walks the metaobject hierarchy once per class, comparing metaobjects,
+and class names for classes the style cannot link against. Results are cached per QMetaObject
+*/
+WidgetKinds widgetKinds(const QObject *object);
+
+}
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(Inspire::WidgetKinds)
+
+#endif